@@ -0,0 +1,69 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <evm_runtime/tables.hpp>
+
+namespace evm_runtime {
+
+// Accumulates the changes an EVM transaction makes to open balances and to inevm. Changes are
+// applied to copies of the rows in the order they happen, so the usual overflow and underflow
+// checks fire exactly as before, and each changed row is written once by flush().
+class balance_ledger {
+public:
+    explicit balance_ledger(eosio::name self) : _balances(self, self.value), _inevm(self, self.value) {}
+
+    // Balance of `owner`, or nullptr if it has none open
+    balance_with_dust* find(eosio::name owner) {
+        auto itr = _entries.find(owner.value);
+        if (itr == _entries.end()) {
+            auto row = _balances.find(owner.value);
+            if (row == _balances.end()) return nullptr;
+            itr = _entries.emplace(owner.value, entry{&*row, row->balance}).first;
+        }
+        return &itr->second.value;
+    }
+
+    balance_with_dust& get(eosio::name owner, const char* error_msg) {
+        auto res = find(owner);
+        eosio::check(res != nullptr, error_msg);
+        return *res;
+    }
+
+    balance_with_dust& inevm() {
+        if (!_inevm_value) {
+            _inevm_original = _inevm.get();
+            _inevm_value = _inevm_original;
+        }
+        return *_inevm_value;
+    }
+
+    void flush() {
+        for (auto& [owner, e] : _entries) {
+            if (e.value == e.row->balance) continue;
+            _balances.modify(*e.row, eosio::same_payer, [&](balance& b) {
+                b.balance = e.value;
+            });
+        }
+        _entries.clear();
+
+        if (_inevm_value && *_inevm_value != _inevm_original) {
+            _inevm.set(*_inevm_value, eosio::same_payer);
+        }
+        _inevm_value.reset();
+    }
+
+private:
+    struct entry {
+        const balance*    row;
+        balance_with_dust value;
+    };
+
+    balances                         _balances;
+    inevm_singleton                  _inevm;
+    std::map<uint64_t, entry>        _entries;
+    balance_with_dust                _inevm_original;
+    std::optional<balance_with_dust> _inevm_value;
+};
+
+} // namespace evm_runtime
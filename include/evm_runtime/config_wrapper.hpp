@@ -13,7 +13,7 @@ struct config_wrapper {
     ~config_wrapper();
 
     void flush();
-    bool exists();
+    bool exists()const;
 
     eosio::unsigned_int get_version()const;
     void set_version(const eosio::unsigned_int version);
@@ -48,6 +48,9 @@ struct config_wrapper {
     uint32_t get_status()const;
     void set_status(uint32_t status);
 
+    bool use_fixed_rows()const;
+    void enable_fixed_rows();
+
     uint64_t get_evm_version()const;
     uint64_t get_evm_version_and_maybe_promote();
     void set_evm_version(uint64_t new_version);
@@ -67,6 +70,11 @@ struct config_wrapper {
     uint64_t get_minimum_natively_representable() const;
 
 private:
+    // The row is read on first use. The fixed-size header (version through status) is decoded
+    // then; the binary extensions that follow it are decoded by cold() only when needed.
+    config& hot()const;
+    config& cold()const;
+
     void set_queue_front_block(uint32_t block_num);
     
     bool is_dirty()const;
@@ -77,8 +85,18 @@ private:
     bool check_gas_overflow(uint64_t gas_txcreate, uint64_t gas_codedeposit) const; // return true if pass
 
     bool _dirty  = false;
-    bool _exists = false;
-    config _cached_config;
+    mutable bool _exists = false;
+    mutable bool _hot_loaded = false;
+    mutable bool _cold_loaded = false;
+    mutable std::vector<char> _raw;
+    mutable size_t _cold_offset = 0;
+    mutable config _cached_config;
+
+    // Promoted values only change in a later block, so they are computed once per action
+    mutable std::optional<uint64_t> _evm_version;
+    mutable std::optional<consensus_parameter_data_type> _consensus_param;
+    bool _evm_version_promoted = false;
+    bool _consensus_param_promoted = false;
 
     eosio::name _self;
     eosio::singleton<"config"_n, config> _config;
@@ -18,6 +18,10 @@ using namespace eosio;
 namespace evm_runtime {
 
 struct gas_prices_type;
+struct tx_stats;
+struct tx_batch;
+struct exec_env;
+class balance_ledger;
 
 class [[eosio::contract]] evm_contract : public contract
 {
@@ -61,7 +65,49 @@ public:
 
    [[eosio::action]] void exec(const exec_input& input, const std::optional<exec_callback>& callback);
 
-   [[eosio::action]] void pushtx(eosio::name miner, bytes rlptx, eosio::binary_extension<uint64_t> min_inclusion_price);
+   /**
+    * @brief Run several read-only calls against the same block context and state cache.
+    *
+    * Returns the packed vector of exec_output, in the order of inputs. Each call starts from the
+    * committed state, so calls do not observe each other. Nothing is written or sent, which makes
+    * the action usable in read-only transactions.
+    */
+   [[eosio::action]] void execbatch(const std::vector<exec_input>& inputs);
+
+   /**
+    * @brief Estimate the gas needed by a call, returned as a packed estimate_output.
+    *
+    * The call is first run with the maximum gas limit and, if it succeeds, the lowest limit it still
+    * succeeds with is found by binary search. All runs share one state cache and nothing is written.
+    */
+   [[eosio::action]] void estimategas(const exec_input& input);
+
+   /**
+    * @brief Read-only state queries, returned packed through the action return value.
+    *
+    * getaccounts returns an account_summary per address, getcode the code of an address (empty if
+    * none) and getstorage up to `limit` slots of an address starting at `cursor`, as a storage_page.
+    */
+   [[eosio::action]] void getaccounts(const std::vector<bytes>& addresses);
+   [[eosio::action]] void getcode(const bytes& address);
+   [[eosio::action]] void getstorage(const bytes& address, const std::optional<storage_cursor>& cursor, uint32_t limit);
+
+   /**
+    * @brief Execute an EVM transaction.
+    *
+    * rlptx and min_inclusion_price are read from the action data by the action itself so the
+    * transaction is decoded in place rather than from a deserialized copy.
+    */
+   [[eosio::action]] void pushtx(eosio::name miner, eosio::ignore<bytes> rlptx, eosio::ignore<eosio::binary_extension<uint64_t>> min_inclusion_price);
+
+   /**
+    * @brief Execute several EVM transactions in order, sharing the block context and state of one action.
+    *
+    * Each transaction gets its own receipt and evmtx event, and a failed EVM execution only affects that
+    * transaction. A transaction that fails validation aborts the whole action, as it would abort pushtx.
+    * Like pushtx, the transactions are decoded in place from the action data.
+    */
+   [[eosio::action]] void pushtxs(eosio::name miner, eosio::ignore<std::vector<bytes>> rlptxs, eosio::ignore<eosio::binary_extension<uint64_t>> min_inclusion_price);
 
    [[eosio::action]] void open(eosio::name owner);
 
@@ -72,6 +118,12 @@ public:
 
    [[eosio::action]] void withdraw(eosio::name owner, eosio::asset quantity, const eosio::binary_extension<eosio::name> &to);
 
+   /// Several withdrawals in one action; transfers to the same recipient are merged
+   [[eosio::action]] void withdrawmany(const std::vector<withdraw_request>& withdrawals);
+
+   /// Bridges funds from the opened balance of `from` to several EVM addresses, each one as a 0x memo transfer would
+   [[eosio::action]] void depositmany(eosio::name from, const std::vector<deposit_request>& deposits);
+
    /// @return true if all garbage has been collected
    [[eosio::action]] bool gc(uint32_t max);
 
@@ -86,6 +138,11 @@ public:
 
    [[eosio::action]] void setversion(uint64_t version);
 
+   /**
+    * @brief Switch account and storage writes to the fixed-width (v2) tables. Can not be undone.
+    */
+   [[eosio::action]] void usefixedrows();
+
    [[eosio::action]] void updtgasparam(eosio::asset ram_price_mb, uint64_t gas_price);
    [[eosio::action]] void setgasparam(uint64_t gas_txnewaccount, uint64_t gas_newaccount, uint64_t gas_txcreate, uint64_t gas_codedeposit, uint64_t gas_sset);
 
@@ -123,22 +180,21 @@ public:
    [[eosio::action]] void dumpall();
    [[eosio::action]] void setbal(const bytes& addy, const bytes& bal);
    [[eosio::action]] void testbaldust(const name test);
+   [[eosio::action]] void testrecover(const bytes& rlptx, const bytes& expected);
+   [[eosio::action]] void testkeccak(const bytes& data, const bytes& expected);
+   [[eosio::action]] std::vector<uint32_t> testalloc(uint32_t rounds);
+   [[eosio::action]] void testslot(uint64_t account_id, const bytes& key, const std::optional<bytes>& value);
 #endif
 
 private:
    void open_internal_balance(eosio::name owner);
    std::shared_ptr<struct config_wrapper> _config;
 
-   enum class status_flags : uint32_t
-   {
-      frozen = 0x1
-   };
-
    void assert_inited();
    void assert_unfrozen();
 
-   silkworm::Receipt execute_tx(const runtime_config& rc, eosio::name miner, silkworm::Block& block, const transaction& tx, silkworm::ExecutionProcessor& ep);
-   void process_filtered_messages(const std::vector<silkworm::FilteredMessage>& filtered_messages);
+   silkworm::Receipt execute_tx(const runtime_config& rc, eosio::name miner, silkworm::Block& block, const transaction& tx, silkworm::ExecutionProcessor& ep, balance_ledger& ledger);
+   void process_filtered_messages(const std::vector<silkworm::FilteredMessage>& filtered_messages, balance_ledger& ledger);
 
    uint64_t get_and_increment_nonce(const name owner);
 
@@ -146,13 +202,23 @@ private:
 
    void handle_account_transfer(const eosio::asset& quantity, const std::string& memo);
    void handle_evm_transfer(eosio::asset quantity, const std::string& memo);
+   void bridge_deposit(tx_batch* batch, std::optional<balance_ledger>& ledger, const eosio::asset& quantity, const evmc::address& destination);
 
    void call_(const runtime_config& rc, intx::uint256 s, const bytes& to, intx::uint256 value, const bytes& data, uint64_t gas_limit, uint64_t nonce);
 
    using pushtx_action = eosio::action_wrapper<"pushtx"_n, &evm_contract::pushtx>;
 
-   void process_tx(const runtime_config& rc, eosio::name miner, const transaction& tx, std::optional<uint64_t> min_inclusion_price);
+   runtime_config pushtx_runtime_config();
+   std::unique_ptr<tx_batch> begin_batch();
+   std::unique_ptr<exec_env> begin_exec();
+   tx_stats process_tx(const runtime_config& rc, eosio::name miner, const transaction& tx, std::optional<uint64_t> min_inclusion_price);
+   tx_stats process_tx(tx_batch& batch, const runtime_config& rc, eosio::name miner, const transaction& tx, std::optional<uint64_t> min_inclusion_price);
    void dispatch_tx(const runtime_config& rc, const transaction& tx);
+   void send_tx_events(tx_batch& batch, const transaction& tx);
+
+   // Deposits to accounts without code skip the EVM and credit the destination directly
+   bool can_fast_deposit(const tx_batch& batch, const evmc::address& destination, const std::optional<silkworm::Account>& account) const;
+   void process_deposit(tx_batch& batch, const transaction& tx, std::optional<silkworm::Account> account, balance_ledger& ledger);
 };
 
 } // namespace evm_runtime
@@ -5,6 +5,12 @@ namespace eosio {
          __attribute__((eosio_wasm_import))
          uint32_t get_code_hash(uint64_t account, uint32_t struct_version, char* data, uint32_t size);
 
+         __attribute__((eosio_wasm_import))
+         int32_t k1_recover(const char* sig, uint32_t sig_len, const char* dig, uint32_t dig_len, char* pub, uint32_t pub_len);
+
+         __attribute__((eosio_wasm_import))
+         void sha3(const char* data, uint32_t data_len, char* hash, uint32_t hash_len, int32_t keccak);
+
         #ifdef WITH_LOGTIME
         __attribute__((eosio_wasm_import))
          void logtime(const char*);
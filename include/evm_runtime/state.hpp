@@ -2,9 +2,12 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <eosio/eosio.hpp>
 #include <evm_runtime/types.hpp>
+#include <evm_runtime/tables.hpp>
 #include <silkworm/core/state/state.hpp>
+#include <silkworm/core/execution/evm.hpp>
 
 namespace evm_runtime {
 
@@ -16,28 +19,90 @@ struct table_stats {
     uint32_t update=0;
     uint32_t create=0;
     uint32_t remove=0;
+
+    EOSLIB_SERIALIZE(table_stats, (read)(update)(create)(remove));
 };
 
 struct db_stats {
     table_stats account;
     table_stats storage;
+    table_stats code;
+    uint64_t    code_bytes=0;  // bytecode loaded from the code table (repeat uses within the action are free)
+    int64_t     ram_delta=0;   // estimated from the per-row figures of the table each row lives in
+
+    EOSLIB_SERIALIZE(db_stats, (account)(storage)(code)(code_bytes)(ram_delta));
+};
+
+// Per-transaction report returned by pushtx when built with WITH_TX_STATS
+struct tx_stats {
+    db_stats db;
+    uint64_t gas_used=0;
+    uint32_t memory_pages=0; // linear memory size once the transaction is done
+
+    EOSLIB_SERIALIZE(tx_stats, (db)(gas_used)(memory_pages));
+};
+
+// Account row loaded from either the legacy or the fixed-width (v2) account table
+struct account_ref {
+    const account*    v1 = nullptr;
+    const account_v2* v2 = nullptr;
+
+    explicit operator bool()const { return v1 || v2; }
+    uint64_t id()const { return v2 ? v2->id : v1->id; }
+    uint64_t nonce()const { return v2 ? v2->nonce : v1->nonce; }
+    uint256be balance()const { return v2 ? v2->get_balance() : v1->get_balance(); }
+    const std::optional<uint64_t>& code_id()const { return v2 ? v2->code_id : v1->code_id; }
+    bool has_flag(account::flag f)const { return v2 ? v2->has_flag(f) : v1->has_flag(f); }
 };
 
+// Number of code analyses kept per action
+static constexpr size_t analysis_cache_size = 32;
+
 struct state : State {
     name _self;
     name _ram_payer;
     bool _read_only;
     bool _allow_frozen;
-    mutable std::map<evmc::address, uint64_t> addr2id;
-    mutable std::map<bytes32, bytes> addr2code;
+    bool _fixed_rows;
+    // Table handles live as long as the state so rows loaded once stay in the multi_index cache
+    mutable account_table _accounts;
+    mutable account_v2_table _accounts_v2;
+    mutable account_code_table _codes;
+    mutable std::map<uint64_t, storage_table> _storages;
+    mutable std::map<uint64_t, storage_v2_table> _storages_v2;
+    // Address -> row overlay shared by the read and write paths (points into the account tables' row cache).
+    // A null ref records an address known not to exist.
+    mutable std::map<evmc::address, account_ref> addr2account;
+    // (account id, slot) pairs known to be empty
+    mutable std::set<std::pair<uint64_t, evmc::bytes32>> missing_slots;
+    // Code hash -> row in the code table's row cache; read_code hands out views into it
+    mutable std::map<bytes32, const account_code*> hash2code;
     mutable db_stats stats;
     std::optional<config2> _config2;
-
-    explicit state(name self, name ram_payer, bool read_only=false, bool allow_frozen=true) : _self(self), _ram_payer(ram_payer), _read_only{read_only}, _allow_frozen{allow_frozen}{}
+    // First gcstore row queued through this state
+    std::optional<uint64_t> _first_new_gc_id;
+    // Jumpdest analysis by code hash, handed to the EVM so a contract is analyzed once per action
+    AnalysisCache analysis_cache{analysis_cache_size};
+
+    explicit state(name self, name ram_payer, bool read_only=false, bool allow_frozen=true, bool fixed_rows=false) :
+        _self(self), _ram_payer(ram_payer), _read_only{read_only}, _allow_frozen{allow_frozen}, _fixed_rows{fixed_rows},
+        _accounts(self, self.value), _accounts_v2(self, self.value), _codes(self, self.value){}
     virtual ~state() override;
 
+    // Fixed-width rows are only ever written once status_flags::fixed_rows is set, so before that
+    // the v2 tables are known to be empty and are never looked up.
+    bool use_fixed_rows()const { return _fixed_rows; }
+
     uint64_t get_next_account_id();
 
+    account_ref find_account(const evmc::address& address) const;
+    storage_table& get_storage_table(uint64_t account_id) const;
+    storage_v2_table& get_storage_v2_table(uint64_t account_id) const;
+
+    // Moves a legacy account row to the fixed-width table keeping its id
+    const account_v2& migrate_account(const evmc::address& address, const account& row);
+    account_ref emplace_account(const evmc::address& address, uint64_t nonce, const uint256& balance, std::optional<uint64_t> code_id);
+
     std::optional<Account> read_account(const evmc::address& address) const noexcept override;
 
     ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
@@ -76,7 +141,9 @@ struct state : State {
                         std::optional<Account> current) override;
 
     /// @return true if all garbage has been collected
-    bool gc(uint32_t max);
+    // Erases up to `max` rows of removed accounts' storage. With `skip_new`, accounts removed
+    // through this state are left for a later call. Returns true when nothing is left.
+    bool gc(uint32_t max, bool skip_new = false);
 
     void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash,
                              ByteView code) override;
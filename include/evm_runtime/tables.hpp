@@ -6,6 +6,7 @@
 #include <eosio/asset.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/binary_extension.hpp>
+#include <eosio/crypto.hpp>
 
 #include <evm_runtime/types.hpp>
 #include <evm_runtime/runtime_config.hpp>
@@ -19,7 +20,8 @@ namespace evm_runtime {
 using namespace eosio;
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] account {
     enum class flag : uint32_t {
-        frozen = 0x1
+        frozen = 0x1,
+        legacy_storage = 0x2 // account_v2 row migrated from account, may still own rows in storage_table
     };
 
     uint64_t    id;
@@ -38,7 +40,7 @@ struct [[eosio::table]] [[eosio::contract("evm_contract")]] account {
     }
 
     inline bool has_flag(flag f)const {
-        return (flags.value() & static_cast<uint32_t>(f) != 0);
+        return (flags.value() & static_cast<uint32_t>(f)) != 0;
     }
 
     uint64_t primary_key()const { return id; }
@@ -53,6 +55,10 @@ struct [[eosio::table]] [[eosio::contract("evm_contract")]] account {
         return res;
     }
 
+    void set_balance(const uint256& value) {
+        balance = to_bytes(value);
+    }
+
     EOSLIB_SERIALIZE(account, (id)(eth_address)(nonce)(balance)(code_id)(flags));
 };
 
@@ -60,6 +66,51 @@ typedef multi_index< "account"_n, account,
     indexed_by<"by.address"_n, const_mem_fun<account, checksum256, &account::by_eth_address>>
 > account_table;
 
+// Fixed-width layout of account, written once status_flags::fixed_rows is set.
+// Rows keep the id they had in account_table so storage scopes are unchanged after migration.
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] account_v2 {
+    using flag = account::flag;
+
+    uint64_t    id;
+    checksum160 eth_address;
+    uint64_t    nonce;
+    checksum256 balance;
+    std::optional<uint64_t> code_id;
+    uint32_t    flags=0;
+
+    void set_flag(flag f) {
+        flags |= static_cast<uint32_t>(f);
+    }
+
+    void clear_flag(flag f) {
+        flags &= ~static_cast<uint32_t>(f);
+    }
+
+    inline bool has_flag(flag f)const {
+        return (flags & static_cast<uint32_t>(f)) != 0;
+    }
+
+    uint64_t primary_key()const { return id; }
+
+    checksum256 by_eth_address()const {
+        return make_key(to_address(eth_address));
+    }
+
+    uint256be get_balance()const {
+        return to_bytes32(balance);
+    }
+
+    void set_balance(const uint256& value) {
+        balance = to_checksum256(value);
+    }
+
+    EOSLIB_SERIALIZE(account_v2, (id)(eth_address)(nonce)(balance)(code_id)(flags));
+};
+
+typedef multi_index< "account2"_n, account_v2,
+    indexed_by<"by.address"_n, const_mem_fun<account_v2, checksum256, &account_v2::by_eth_address>>
+> account_v2_table;
+
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] account_code {
     uint64_t    id;
     uint32_t    ref_count;
@@ -94,6 +145,10 @@ struct [[eosio::table]] [[eosio::contract("evm_contract")]] storage {
         return make_key(key);
     }
 
+    evmc::bytes32 get_value()const {
+        return to_bytes32(value);
+    }
+
     EOSLIB_SERIALIZE(storage, (id)(key)(value));
 };
 
@@ -101,6 +156,84 @@ typedef multi_index< "storage"_n, storage,
     indexed_by<"by.key"_n, const_mem_fun<storage, checksum256, &storage::by_key>> 
 > storage_table;
 
+// Fixed-width layout of storage, written once status_flags::fixed_rows is set.
+// The primary key is derived from the slot key so a slot is found without a secondary index.
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] storage_v2 {
+    uint64_t    id;
+    checksum256 key;
+    checksum256 value;
+
+    uint64_t primary_key()const { return id; }
+
+    evmc::bytes32 get_value()const {
+        return to_bytes32(value);
+    }
+
+    // Position where the chain of `key` starts: first 8 bytes (little endian) of sha256(key || account_id).
+    // Hashing keeps both crafted keys and clustered solidity slots spread over the id space.
+    // Colliding keys take the next free id (see find_slot).
+    static uint64_t home_id(const checksum256& key, uint64_t account_id) {
+        uint8_t buffer[40];
+        const auto key_bytes = key.extract_as_byte_array();
+        memcpy(buffer, key_bytes.data(), key_bytes.size());
+        memcpy(buffer + key_bytes.size(), &account_id, sizeof(account_id));
+        const auto digest = eosio::sha256((const char*)buffer, sizeof(buffer)).extract_as_byte_array();
+        uint64_t id;
+        memcpy(&id, digest.data(), sizeof(id));
+        return id;
+    }
+
+    EOSLIB_SERIALIZE(storage_v2, (id)(key)(value));
+};
+
+typedef multi_index< "storage2"_n, storage_v2> storage_v2_table;
+
+// Longest collision chain find_slot walks before giving up
+static constexpr uint64_t max_slot_probe = 16;
+
+// Maps a key to the id its chain starts at. Tests pass their own to build chains on purpose.
+using home_id_fn = uint64_t (*)(const checksum256& key, uint64_t account_id);
+
+// Walks the collision chain of `key`. Returns the row holding it, or end() with
+// `free_id` set to the id a new row for `key` has to use.
+inline storage_v2_table::const_iterator find_slot(const storage_v2_table& db, const checksum256& key, uint64_t& free_id,
+                                                  home_id_fn home_id = &storage_v2::home_id) {
+    const uint64_t home = home_id(key, db.get_scope());
+    for(uint64_t id = home;; ++id) {
+        eosio::check(id - home < max_slot_probe, "storage slot probe limit exceeded");
+        auto itr = db.find(id);
+        if(itr == db.end()) {
+            free_id = id;
+            return itr;
+        }
+        if(itr->key == key) {
+            return itr;
+        }
+    }
+}
+
+// Erases a slot and shifts the rest of its chain back so no chain is broken by the gap
+inline void erase_slot(storage_v2_table& db, storage_v2_table::const_iterator itr, name payer,
+                       home_id_fn home_id = &storage_v2::home_id) {
+    const uint64_t account_id = db.get_scope();
+    uint64_t hole = itr->id;
+    db.erase(itr);
+    for(uint64_t id = hole + 1;; ++id) {
+        auto next = db.find(id);
+        if(next == db.end()) break;
+        // Rows whose home id lies (cyclically) in (hole, id] are still reachable
+        if(id - home_id(next->key, account_id) < id - hole) continue;
+        const storage_v2 moved = *next;
+        db.erase(next);
+        db.emplace(payer, [&](auto& row){
+            row.id = hole;
+            row.key = moved.key;
+            row.value = moved.value;
+        });
+        hole = id;
+    }
+}
+
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] gcstore {
     uint64_t id;
     uint64_t storage_id;
@@ -256,6 +389,14 @@ using evm_version_type = uint64_t;
 VALUE_PROMOTER(evm_version_type);
 VALUE_PROMOTER_REV(consensus_parameter_data_type);
 
+// Bits of config::status
+enum class status_flags : uint32_t
+{
+    frozen = 0x1,
+    // Account and storage rows are written using the fixed-width (v2) layout. Never cleared.
+    fixed_rows = 0x2
+};
+
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] config
 {
     unsigned_int version; // placeholder for future variant index
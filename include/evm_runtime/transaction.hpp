@@ -3,6 +3,7 @@
 #include <optional>
 #include <eosio/eosio.hpp>
 #include <evm_runtime/types.hpp>
+#include <ethash/keccak.hpp>
 #include <silkworm/core/rlp/encode.hpp>
 #include <silkworm/core/types/transaction.hpp>
 
@@ -11,14 +12,29 @@ namespace evm_runtime {
 using silkworm::Bytes;
 using silkworm::ByteView;
 
+// Recovers the sender of a regularly signed transaction using the host's k1_recover
+std::optional<evmc::address> recover_sender_host(const silkworm::Transaction& tx);
+std::optional<evmc::address> recover_sender_host(const silkworm::Transaction& tx, const ethash::hash256& signing_hash);
+
+// Hash of the signing payload, built by patching the raw (unwrapped) RLP in place and restoring it
+// afterwards instead of re-encoding the transaction. Empty if the encoding is not one we can patch.
+std::optional<ethash::hash256> signing_hash(char* rlptx, size_t size, const silkworm::Transaction& tx);
+
 struct transaction {
 
   transaction() = delete;
   explicit transaction(bytes rlptx) : rlptx_(std::move(rlptx)) {}
   explicit transaction(silkworm::Transaction tx) : tx_(std::move(tx)) {}
+  // Decodes in place from a buffer owned by the caller (e.g. the action data), which must outlive
+  // the transaction. The buffer is briefly patched while hashing for sender recovery.
+  transaction(char* rlptx, size_t size) : raw_(rlptx), raw_size_(size) {}
 
   const bytes& get_rlptx()const {
     if(!rlptx_) {
+      if(raw_) {
+        rlptx_.emplace(raw_, raw_ + raw_size_);
+        return rlptx_.value();
+      }
       eosio::check(tx_.has_value(), "no tx");
       Bytes rlp;
       silkworm::rlp::encode(rlp, tx_.value());
@@ -29,11 +45,11 @@ struct transaction {
 
   const silkworm::Transaction& get_tx()const {
     if(!tx_) {
-      eosio::check(rlptx_.has_value(), "no rlptx");
-      ByteView bv{(const uint8_t*)rlptx_->data(), rlptx_->size()};
+      eosio::check(raw_ || rlptx_.has_value(), "no rlptx");
+      ByteView bv = raw_ ? ByteView{(const uint8_t*)raw_, raw_size_} : ByteView{(const uint8_t*)rlptx_->data(), rlptx_->size()};
       silkworm::Transaction tmp;
       eosio::check(silkworm::rlp::decode_transaction(bv, tmp, silkworm::rlp::Eip2718Wrapping::kNone) && bv.empty(), "unable to decode transaction");
-      tx_.emplace(tmp);
+      tx_.emplace(std::move(tmp));
     }
     return tx_.value();
   }
@@ -42,12 +58,24 @@ struct transaction {
     eosio::check(tx_.has_value(), "no tx");
     auto& tx = tx_.value();
     tx.from.reset();
+#ifdef WITH_HOST_K1_RECOVER
+    // Special (bridge) signatures do not carry a real key and stay with silkworm
+    if (!silkworm::is_special_signature(tx.r, tx.s)) {
+      std::optional<ethash::hash256> hash;
+      if (raw_) hash = signing_hash(raw_, raw_size_, tx);
+      else if (rlptx_) hash = signing_hash(rlptx_->data(), rlptx_->size(), tx);
+      tx.from = hash ? recover_sender_host(tx, *hash) : recover_sender_host(tx);
+      return;
+    }
+#endif
     tx.recover_sender();
   }
 
 private:
   mutable std::optional<bytes>  rlptx_;
   mutable std::optional<silkworm::Transaction> tx_;
+  char*  raw_ = nullptr;
+  size_t raw_size_ = 0;
 };
 
 } //namespace evm_runtime
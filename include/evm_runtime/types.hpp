@@ -15,6 +15,28 @@ namespace evm_runtime {
    static constexpr uint64_t one_gwei = 1'000'000'000ull;
    static constexpr uint64_t gas_sset_min = 2900;
    static constexpr uint64_t grace_period_seconds = 180;
+   // Storage rows of removed accounts freed at the end of each EVM transaction
+   static constexpr uint32_t gc_rows_per_tx = 16;
+   // RAM billed per table row on top of its serialized size, and per checksum256 secondary index entry
+   static constexpr uint64_t row_overhead_bytes = 120;
+   static constexpr uint64_t index256_bytes = 152;
+   // RAM billed for a new account and for a contract's code row (excluding the code itself).
+   // account row: id(8) eth_address(1+20) nonce(8) balance(1+32) code_id(1) flags(4) = 75, plus its by.address entry
+   static constexpr uint64_t account_bytes = 75 + row_overhead_bytes + index256_bytes;
+   // account2 row: id(8) eth_address(20) nonce(8) balance(32) code_id(1) flags(4) = 73, plus its by.address entry
+   static constexpr uint64_t account_v2_bytes = 73 + row_overhead_bytes + index256_bytes;
+   static constexpr uint64_t contract_fixed_bytes = 606;
+   // RAM billed for a new storage slot with a full 32 byte value.
+   // storage row: id(8) key(1+32) value(1+32) = 74, plus its by.key entry
+   static constexpr uint64_t storage_slot_bytes = 74 + row_overhead_bytes + index256_bytes;
+   // storage2 row: id(8) key(32) value(32) = 72 and no secondary index
+   static constexpr uint64_t storage_slot_v2_bytes = 72 + row_overhead_bytes;
+   // The legacy figures are consensus parameters already in use
+   static_assert(account_bytes == 347 && storage_slot_bytes == 346);
+
+   constexpr uint64_t storage_slot_bytes_for(bool fixed_rows) {
+      return fixed_rows ? storage_slot_v2_bytes : storage_slot_bytes;
+   }
 
    uint64_t pow10_const(int v);
 
@@ -41,6 +63,12 @@ namespace evm_runtime {
    evmc::bytes32 to_bytes32(const bytes& data);
    uint256 to_uint256(const bytes& value);
 
+   eosio::checksum160 to_checksum160(const evmc::address& addr);
+   eosio::checksum256 to_checksum256(const uint256& val);
+   evmc::address to_address(const eosio::checksum160& addr);
+   evmc::bytes32 to_bytes32(const eosio::checksum256& data);
+   uint256 to_uint256(const eosio::checksum256& value);
+
    struct exec_input {
       std::optional<bytes> context;
       std::optional<bytes> from;
@@ -66,6 +94,63 @@ namespace evm_runtime {
       EOSLIB_SERIALIZE(exec_output, (status)(data)(context));
    };
 
+   struct estimate_output {
+      int32_t  status;     ///< Status of the call at the maximum gas limit
+      uint64_t gas;        ///< Lowest gas limit the call succeeds with, excluding the intrinsic gas
+      uint64_t gas_used;   ///< Gas used at the maximum gas limit, before the refund
+      uint64_t gas_refund; ///< Refund accumulated at the maximum gas limit
+      bytes    data;       ///< Output (or revert data) at the maximum gas limit
+
+      EOSLIB_SERIALIZE(estimate_output, (status)(gas)(gas_used)(gas_refund)(data));
+   };
+
+   struct withdraw_request {
+      eosio::name                owner;
+      eosio::asset               quantity;
+      std::optional<eosio::name> to;   ///< defaults to owner
+
+      EOSLIB_SERIALIZE(withdraw_request, (owner)(quantity)(to));
+   };
+
+   struct deposit_request {
+      bytes        address;   ///< 20 bytes EVM address
+      eosio::asset quantity;  ///< ingress bridge fee is taken from each deposit
+
+      EOSLIB_SERIALIZE(deposit_request, (address)(quantity));
+   };
+
+   struct account_summary {
+      bytes    address;
+      bool     exists;
+      uint64_t nonce;
+      bytes    balance;   ///< 32 bytes, big endian
+      bytes    code_hash;
+
+      EOSLIB_SERIALIZE(account_summary, (address)(exists)(nonce)(balance)(code_hash));
+   };
+
+   // Position of the next storage row of an account: legacy storage rows come first, then storage2 rows
+   struct storage_cursor {
+      bool     v2;
+      uint64_t id;
+
+      EOSLIB_SERIALIZE(storage_cursor, (v2)(id));
+   };
+
+   struct storage_entry {
+      bytes key;
+      bytes value;
+
+      EOSLIB_SERIALIZE(storage_entry, (key)(value));
+   };
+
+   struct storage_page {
+      std::vector<storage_entry>    entries;
+      std::optional<storage_cursor> next;   ///< Empty once all rows have been returned
+
+      EOSLIB_SERIALIZE(storage_page, (entries)(next));
+   };
+
    struct bridge_message_v0 {
       eosio::name        receiver;
       bytes              sender;
@@ -9,6 +9,7 @@
 #include <evm_runtime/eosio.token.hpp>
 #include <evm_runtime/bridge.hpp>
 #include <evm_runtime/config_wrapper.hpp>
+#include <evm_runtime/balance_ledger.hpp>
 
 #include <silkworm/core/protocol/trust_rule_set.hpp>
 // included here so NDEBUG is defined to disable assert macro
@@ -180,9 +181,8 @@ void check_result( ValidationResult r, const Transaction& txn, const char* desc
     eosio::check( false, std::move(err_msg));
 }
 
-Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Block& block, const transaction& txn, silkworm::ExecutionProcessor& ep) {
+Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Block& block, const transaction& txn, silkworm::ExecutionProcessor& ep, balance_ledger& ledger) {
     const auto& tx = txn.get_tx();
-    balances balance_table(get_self(), get_self().value);
 
     if (miner == get_self()) {
         // If the miner is the contract itself, then there is no need to send the miner its cut.
@@ -191,18 +191,11 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
 
     if (miner) {
         // Ensure the miner has a balance open early.
-        balance_table.get(miner.value, "no balance open for miner");
+        ledger.get(miner, "no balance open for miner");
     }
 
     bool deducted_miner_cut = false;
 
-    std::optional<inevm_singleton> inevm;
-    auto populate_bridge_accessors = [&]() {
-        if(inevm)
-            return;
-        inevm.emplace(get_self(), get_self().value);
-    };
-
     bool is_special_signature = silkworm::is_special_signature(tx.r, tx.s);
 
     txn.recover_sender();
@@ -222,11 +215,8 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
             check(max_gas_cost + tx.value < std::numeric_limits<intx::uint256>::max(), "too much gas");
             const intx::uint256 value_with_max_gas = tx.value + (intx::uint256)max_gas_cost;
 
-            populate_bridge_accessors();
-            balance_table.modify(balance_table.get(ingress_account.value), eosio::same_payer, [&](balance& b){
-                b.balance -= value_with_max_gas;
-            });
-            inevm->set(inevm->get() += value_with_max_gas, eosio::same_payer);
+            ledger.get(ingress_account, "unable to find key") -= value_with_max_gas;
+            ledger.inevm() += value_with_max_gas;
 
             ep.state().set_balance(*tx.from, value_with_max_gas);
             ep.state().set_nonce(*tx.from, tx.nonce);
@@ -274,7 +264,6 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
     if(!ep.state().reserved_objects().empty()) {
         bool non_open_account_sent = false;
         intx::uint256 total_egress;
-        populate_bridge_accessors();
 
         for(const auto& reserved_object : ep.state().reserved_objects()) {
             const evmc::address& address = reserved_object.first;
@@ -288,15 +277,13 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
                 continue;
             total_egress += reserved_account.balance;
 
-            if(auto it = balance_table.find(egress_account.value); it != balance_table.end()) {
-                balance_table.modify(balance_table.get(egress_account.value), eosio::same_payer, [&](balance& b){
-                    b.balance += reserved_account.balance;
-                    if (gas_fee_miner_portion.has_value() && egress_account == get_self()) {
-                        check(!deducted_miner_cut, "unexpected error: contract account appears twice in reserved objects");
-                        b.balance -= *gas_fee_miner_portion;
-                        deducted_miner_cut = true;
-                    }
-                });
+            if(auto b = ledger.find(egress_account)) {
+                *b += reserved_account.balance;
+                if (gas_fee_miner_portion.has_value() && egress_account == get_self()) {
+                    check(!deducted_miner_cut, "unexpected error: contract account appears twice in reserved objects");
+                    *b -= *gas_fee_miner_portion;
+                    deducted_miner_cut = true;
+                }
             }
             else {
                 check(!non_open_account_sent, "only one non-open account for egress bridging allowed in single transaction");
@@ -319,70 +306,92 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
         }
 
         if(total_egress != 0_u256)
-            inevm->set(inevm->get() -= total_egress, eosio::same_payer);
+            ledger.inevm() -= total_egress;
     }
 
     // Send miner portion of the gas fee, if any, to the balance of the miner:
     if (gas_fee_miner_portion.has_value() && *gas_fee_miner_portion != 0) {
         check(deducted_miner_cut, "unexpected error: contract account did not receive any funds through its reserved address");
-        balance_table.modify(balance_table.get(miner.value), eosio::same_payer, [&](balance& b){
-            b.balance += *gas_fee_miner_portion;
-        });
+        ledger.get(miner, "no balance open for miner") += *gas_fee_miner_portion;
     }
 
     LOGTIME("EVM EXECUTE");
     return receipt;
 }
 
-void evm_contract::exec(const exec_input& input, const std::optional<exec_callback>& callback) {
+// Block context, state cache and gas parameters shared by the calls of exec and execbatch
+struct exec_env {
+    const ChainConfig* chain_config;
+    Block block;
+    evm_runtime::state state;
+    evmone::gas_parameters gas_params;
+
+    exec_env(eosio::name self, config_wrapper& config, const ChainConfig& chain)
+        : chain_config{&chain}, state{self, self, true, true, config.use_fixed_rows()},
+          gas_params{std::visit([&](const auto &v) {
+              return evmone::gas_parameters(
+                  v.gas_parameter.gas_txnewaccount,
+                  v.gas_parameter.gas_newaccount,
+                  v.gas_parameter.gas_txcreate,
+                  v.gas_parameter.gas_codedeposit,
+                  v.gas_parameter.gas_sset
+              );
+          }, config.get_consensus_param())} {}
+
+    static constexpr uint64_t max_gas = 0x7ffffffffff;
+
+    // Each call gets its own IntraBlockState so it never sees the changes of a previous one
+    CallResult call(const exec_input& input, uint64_t gas, uint64_t* refund = nullptr) {
+        IntraBlockState ibstate{state};
+        EVM evm{block, ibstate, *chain_config, gas_params};
+        evm.analysis_cache = &state.analysis_cache;
+
+        Transaction txn;
+        txn.to    = to_address(input.to);
+        txn.data  = Bytes{input.data.begin(), input.data.end()};
+        txn.from  = input.from.has_value()  ? to_address(input.from.value()) : evmc::address{};
+        txn.value = input.value.has_value() ? to_uint256(input.value.value()) : 0;
+
+        CallResult res{evm.execute(txn, gas)};
+        if (refund) *refund = ibstate.get_refund();
+        return res;
+    }
 
-    assert_unfrozen();
+    exec_output run(const exec_input& input) {
+        const CallResult vm_res{call(input, max_gas)};
+
+        return exec_output{
+            .status  = int32_t(vm_res.status),
+            .data    = bytes{vm_res.data.begin(), vm_res.data.end()},
+            .context = input.context
+        };
+    }
+};
 
+std::unique_ptr<exec_env> evm_contract::begin_exec() {
     std::optional<std::pair<const std::string, const ChainConfig*>> found_chain_config = lookup_known_chain(_config->get_chainid());
     check( found_chain_config.has_value(), "unknown chainid" );
 
     eosevm::block_mapping bm(_config->get_genesis_time().sec_since_epoch());
 
-    Block block;
-
     auto evm_version = _config->get_evm_version();
+    auto env = std::make_unique<exec_env>(get_self(), *_config, *found_chain_config->second);
+
     std::optional<uint64_t> base_fee_per_gas;
     if (evm_version >= 1) {
         base_fee_per_gas = _config->get_gas_price();
     }
-    eosevm::prepare_block_header(block.header, bm, get_self().value,
+    eosevm::prepare_block_header(env->block.header, bm, get_self().value,
         bm.timestamp_to_evm_block_num(eosio::current_time_point().time_since_epoch().count()), evm_version, base_fee_per_gas);
 
-    evm_runtime::state state{get_self(), get_self(), true};
-    IntraBlockState ibstate{state};
-
-    const auto& consensus_param = _config->get_consensus_param();
-
-    auto gas_params = std::visit([&](const auto &v) {
-        return evmone::gas_parameters(
-            v.gas_parameter.gas_txnewaccount,
-            v.gas_parameter.gas_newaccount,
-            v.gas_parameter.gas_txcreate,
-            v.gas_parameter.gas_codedeposit,
-            v.gas_parameter.gas_sset
-        );
-    }, consensus_param);
+    return env;
+}
 
-    EVM evm{block, ibstate, *found_chain_config.value().second, gas_params};
+void evm_contract::exec(const exec_input& input, const std::optional<exec_callback>& callback) {
 
-    Transaction txn;
-    txn.to    = to_address(input.to);
-    txn.data  = Bytes{input.data.begin(), input.data.end()};
-    txn.from  = input.from.has_value()  ? to_address(input.from.value()) : evmc::address{};
-    txn.value = input.value.has_value() ? to_uint256(input.value.value()) : 0;
+    assert_unfrozen();
 
-    const CallResult vm_res{evm.execute(txn, 0x7ffffffffff)};
-
-    exec_output output{
-        .status  = int32_t(vm_res.status),
-        .data    = bytes{vm_res.data.begin(), vm_res.data.end()},
-        .context = input.context
-    };
+    auto output = begin_exec()->run(input);
 
     if(callback.has_value()) {
         const auto& cb = callback.value();
@@ -394,8 +403,67 @@ void evm_contract::exec(const exec_input& input, const std::optional<exec_callba
     }
 }
 
-void evm_contract::process_filtered_messages(const std::vector<silkworm::FilteredMessage>& filtered_messages ) {
+void evm_contract::execbatch(const std::vector<exec_input>& inputs) {
+
+    assert_unfrozen();
+
+    auto env = begin_exec();
+
+    std::vector<exec_output> outputs;
+    outputs.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        outputs.push_back(env->run(input));
+    }
+
+    auto outputs_bin = eosio::pack(outputs);
+    set_action_return_value(outputs_bin.data(), outputs_bin.size());
+}
+
+void evm_contract::estimategas(const exec_input& input) {
+
+    assert_unfrozen();
+
+    auto env = begin_exec();
+
+    uint64_t refund = 0;
+    const CallResult vm_res{env->call(input, exec_env::max_gas, &refund)};
+    const uint64_t gas_used = exec_env::max_gas - vm_res.gas_left;
+
+    estimate_output output{
+        .status     = int32_t(vm_res.status),
+        .gas        = gas_used,
+        .gas_used   = gas_used,
+        .gas_refund = refund,
+        .data       = bytes{vm_res.data.begin(), vm_res.data.end()}
+    };
 
+    if (vm_res.status == EVMC_SUCCESS && gas_used > 0) {
+        // Anything below the gas used fails; the 63/64 rule for nested calls can push the
+        // minimum above it, so try a margin first before bisecting.
+        uint64_t lo = gas_used - 1;
+        uint64_t hi = exec_env::max_gas;
+        auto succeeds = [&](uint64_t gas) { return env->call(input, gas).status == EVMC_SUCCESS; };
+
+        uint64_t guess = gas_used + gas_used / 63 + 1;
+        if (guess < hi) {
+            if (succeeds(guess)) hi = guess;
+            else lo = guess;
+        }
+        while (hi - lo > 1) {
+            uint64_t mid = lo + (hi - lo) / 2;
+            if (succeeds(mid)) hi = mid;
+            else lo = mid;
+        }
+        output.gas = hi;
+    }
+
+    auto output_bin = eosio::pack(output);
+    set_action_return_value(output_bin.data(), output_bin.size());
+}
+
+void evm_contract::process_filtered_messages(const std::vector<silkworm::FilteredMessage>& filtered_messages, balance_ledger& ledger) {
+
+    message_receiver_table message_receivers(get_self(), get_self().value);
     intx::uint256 accumulated_value;
     for(const auto& rawmsg : filtered_messages) {
 
@@ -407,7 +475,6 @@ void evm_contract::process_filtered_messages(const std::vector<silkworm::Filtere
         const auto& receiver = msg_v0.get_account_as_name();
         eosio::check(eosio::is_account(receiver), "receiver is not account");
 
-        message_receiver_table message_receivers(get_self(), get_self().value);
         auto it = message_receivers.find(receiver.value);
         eosio::check(it != message_receivers.end(), "receiver not registered");
 
@@ -419,8 +486,7 @@ void evm_contract::process_filtered_messages(const std::vector<silkworm::Filtere
         auto value = intx::be::unsafe::load<uint256>(rawmsg.value.bytes);
         eosio::check(value >= min_fee, "min_fee not covered");
 
-        balances balance_table(get_self(), get_self().value);
-        const balance& receiver_account = balance_table.get(receiver.value, "receiver account is not open");
+        auto& receiver_balance = ledger.get(receiver, "receiver account is not open");
 
         action(std::vector<permission_level>{}, it->handler, "onbridgemsg"_n,
             bridge_message{ bridge_message_v0 {
@@ -432,30 +498,46 @@ void evm_contract::process_filtered_messages(const std::vector<silkworm::Filtere
             } }
         ).send();
 
-        balance_table.modify(receiver_account, eosio::same_payer, [&](balance& row) {
-            row.balance += value;
-        });
+        receiver_balance += value;
 
         accumulated_value += value;
     }
 
     if(accumulated_value > 0) {
-        balances balance_table(get_self(), get_self().value);
-        const balance& self_balance = balance_table.get(get_self().value);
-        balance_table.modify(self_balance, eosio::same_payer, [&](balance& row) {
-            row.balance -= accumulated_value;
-        });
+        ledger.get(get_self(), "unable to find key") -= accumulated_value;
     }
 
 }
 
-void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const transaction& txn, std::optional<uint64_t> min_inclusion_price) {
-    LOGTIME("EVM START1");
-
-    const auto& tx = txn.get_tx();
-    eosio::check(rc.allow_non_self_miner || miner == get_self(),
-                 "unexpected error: EVM contract generated inline pushtx without setting itself as the miner");
-
+// Execution environment shared by the transactions of one action
+struct tx_batch {
+    uint64_t current_version;
+    std::pair<consensus_parameter_data_type, bool> gas_param_pair;
+    const ChainConfig* chain_config;
+    Block block;
+    std::optional<uint64_t> base_fee_per_gas;
+    gas_prices_type gas_prices;
+    silkworm::protocol::TrustRuleSet engine;
+    evm_runtime::state state;
+    evmone::gas_parameters gas_params;
+    bool config_change_sent = false;
+
+    tx_batch(eosio::name self, config_wrapper& config, uint64_t version,
+             std::pair<consensus_parameter_data_type, bool> param_pair, const ChainConfig& chain)
+        : current_version{version}, gas_param_pair{std::move(param_pair)}, chain_config{&chain},
+          gas_prices{config.get_gas_prices()}, engine{chain}, state{self, self, false, false, config.use_fixed_rows()},
+          gas_params{std::visit([&](const auto &v) {
+              return evmone::gas_parameters(
+                  v.gas_parameter.gas_txnewaccount,
+                  v.gas_parameter.gas_newaccount,
+                  v.gas_parameter.gas_txcreate,
+                  v.gas_parameter.gas_codedeposit,
+                  v.gas_parameter.gas_sset
+              );
+          }, gas_param_pair.first)} {}
+};
+
+std::unique_ptr<tx_batch> evm_contract::begin_batch() {
     auto current_version = _config->get_evm_version_and_maybe_promote();
 
     auto gas_param_pair = _config->get_consensus_param_and_maybe_promote();
@@ -467,46 +549,53 @@ void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const
     std::optional<std::pair<const std::string, const ChainConfig*>> found_chain_config = lookup_known_chain(_config->get_chainid());
     check( found_chain_config.has_value(), "unknown chainid" );
 
-    eosevm::block_mapping bm(_config->get_genesis_time().sec_since_epoch());
+    auto batch = std::make_unique<tx_batch>(get_self(), *_config, current_version, std::move(gas_param_pair), *found_chain_config->second);
 
-    Block block;
+    eosevm::block_mapping bm(_config->get_genesis_time().sec_since_epoch());
 
-    std::optional<uint64_t> base_fee_per_gas;
-    auto gas_prices = _config->get_gas_prices();
     if (current_version >= 1) {
         if( current_version >= 3) {
             //base_fee_per_gas = f(gas_prices, min_inclusion_price)
         } else {
-            base_fee_per_gas = _config->get_gas_price();
+            batch->base_fee_per_gas = _config->get_gas_price();
         }
     }
 
-    eosevm::prepare_block_header(block.header, bm, get_self().value,
-        bm.timestamp_to_evm_block_num(eosio::current_time_point().time_since_epoch().count()), current_version, base_fee_per_gas);
+    eosevm::prepare_block_header(batch->block.header, bm, get_self().value,
+        bm.timestamp_to_evm_block_num(eosio::current_time_point().time_since_epoch().count()), current_version, batch->base_fee_per_gas);
+
+    return batch;
+}
+
+tx_stats evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const transaction& txn, std::optional<uint64_t> min_inclusion_price) {
+    auto batch = begin_batch();
+    return process_tx(*batch, rc, miner, txn, min_inclusion_price);
+}
 
-    silkworm::protocol::TrustRuleSet engine{*found_chain_config->second};
+tx_stats evm_contract::process_tx(tx_batch& batch, const runtime_config& rc, eosio::name miner, const transaction& txn, std::optional<uint64_t> min_inclusion_price) {
+    LOGTIME("EVM START1");
 
-    evm_runtime::state state{get_self(), get_self(), false, false};
+    const auto& tx = txn.get_tx();
+    eosio::check(rc.allow_non_self_miner || miner == get_self(),
+                 "unexpected error: EVM contract generated inline pushtx without setting itself as the miner");
 
-    auto gas_params = std::visit([&](const auto &v) {
-        return evmone::gas_parameters(
-            v.gas_parameter.gas_txnewaccount,
-            v.gas_parameter.gas_newaccount,
-            v.gas_parameter.gas_txcreate,
-            v.gas_parameter.gas_codedeposit,
-            v.gas_parameter.gas_sset
-        );
-    }, gas_param_pair.first);
+    const auto current_version = batch.current_version;
+    auto& state = batch.state;
 
     if (current_version >= 1) {
-        auto inclusion_price = std::min(tx.max_priority_fee_per_gas, tx.max_fee_per_gas - *base_fee_per_gas);
+        auto inclusion_price = std::min(tx.max_priority_fee_per_gas, tx.max_fee_per_gas - *batch.base_fee_per_gas);
         eosio::check(inclusion_price >= (min_inclusion_price.has_value() ? *min_inclusion_price : 0), "inclusion price must >= min_inclusion_price");
     } else { // old behavior
         check(tx.max_priority_fee_per_gas == tx.max_fee_per_gas, "max_priority_fee_per_gas must be equal to max_fee_per_gas");
         check(tx.max_fee_per_gas >= _config->get_gas_price(), "gas price is too low");
     }
 
-    silkworm::ExecutionProcessor ep{block, engine, state, *found_chain_config->second, gas_params};
+    state.stats = {};
+
+    // A fresh processor per transaction: its IntraBlockState tracks reserved addresses and
+    // filtered messages for a single transaction. The state below it is shared by the batch.
+    silkworm::ExecutionProcessor ep{batch.block, batch.engine, state, *batch.chain_config, batch.gas_params};
+    ep.evm().analysis_cache = &state.analysis_cache;
 
     // Filter EVM messages (with data) that are sent to the reserved address
     // corresponding to the EOS account holding the contract (self)
@@ -515,35 +604,85 @@ void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const
         return message.recipient == me && message.input_size > 0;
     });
 
-    auto receipt = execute_tx(rc, miner, block, txn, ep);
+    // Balance rows touched by egress, the miner cut and bridge messages are written once
+    balance_ledger ledger{get_self()};
+    auto receipt = execute_tx(rc, miner, batch.block, txn, ep, ledger);
 
-    process_filtered_messages(ep.state().filtered_messages());
+    process_filtered_messages(ep.state().filtered_messages(), ledger);
+    ledger.flush();
 
-    engine.finalize(ep.state(), ep.evm().block());
+    batch.engine.finalize(ep.state(), ep.evm().block());
     ep.state().write_to_db(ep.evm().block().header.number);
 
-    if (gas_param_pair.second) {
+    // Drain the backlog of removed accounts a little on every transaction
+    state.gc(gc_rows_per_tx, true);
+
+    send_tx_events(batch, txn);
+    LOGTIME("EVM END");
+
+    return tx_stats{state.stats, receipt.cumulative_gas_used, uint32_t(__builtin_wasm_memory_size(0))};
+}
+
+void evm_contract::send_tx_events(tx_batch& batch, const transaction& txn) {
+    const auto current_version = batch.current_version;
+
+    if (batch.gas_param_pair.second && !batch.config_change_sent) {
         configchange_action act{get_self(), std::vector<eosio::permission_level>()};
-        act.send(gas_param_pair.first);
+        act.send(batch.gas_param_pair.first);
+        batch.config_change_sent = true;
     }
 
     if(current_version >= 3) {
-        auto event = evmtx_type{evmtx_v3{current_version, txn.get_rlptx(), gas_prices.overhead_price, gas_prices.storage_price}};
+        auto event = evmtx_type{evmtx_v3{current_version, txn.get_rlptx(), batch.gas_prices.overhead_price, batch.gas_prices.storage_price}};
         action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
     } else if (current_version >= 1) {
-        auto event = evmtx_type{evmtx_v1{current_version, txn.get_rlptx(), *base_fee_per_gas}};
+        auto event = evmtx_type{evmtx_v1{current_version, txn.get_rlptx(), *batch.base_fee_per_gas}};
         action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
     }
-    LOGTIME("EVM END");
 }
 
-void evm_contract::pushtx(eosio::name miner, bytes rlptx, eosio::binary_extension<uint64_t> min_inclusion_price) {
-    LOGTIME("EVM START0");
-    assert_unfrozen();
+bool evm_contract::can_fast_deposit(const tx_batch& batch, const evmc::address& destination, const std::optional<Account>& account) const {
+    // The storage gas of version 3 is left to the EVM
+    if (batch.current_version < 1 || batch.current_version >= 3) return false;
 
-    auto evm_version = _config->get_evm_version();
-    if (evm_version >= 1) _config->process_price_queue();
+    // Reserved addresses bridge out and precompiles execute; both need the EVM
+    if (is_reserved_address(destination)) return false;
+    if (std::all_of(destination.bytes, destination.bytes + sizeof(destination.bytes) - 2, [](uint8_t b) { return b == 0; })) return false;
+
+    return !account || account->code_hash == kEmptyHash;
+}
 
+void evm_contract::process_deposit(tx_batch& batch, const transaction& txn, std::optional<Account> account, balance_ledger& ledger) {
+    LOGTIME("EVM START DEPOSIT");
+
+    const auto& tx = txn.get_tx();
+    auto& state = batch.state;
+    state.stats = {};
+
+    // Same ledger movements as execute_tx for a bridge transaction: the sender is funded with the
+    // value and the maximum gas cost, and the unused gas and the fee come back through reserved
+    // addresses of the contract, so only the value stays in the EVM.
+    const intx::uint512 max_gas_cost = intx::uint256(tx.gas_limit) * tx.max_fee_per_gas;
+    check(max_gas_cost + tx.value < std::numeric_limits<intx::uint256>::max(), "too much gas");
+    const intx::uint256 value_with_max_gas = tx.value + (intx::uint256)max_gas_cost;
+
+    auto& self_balance = ledger.get(get_self(), "unable to find key");
+    self_balance -= value_with_max_gas;
+    self_balance += (intx::uint256)max_gas_cost;
+    ledger.inevm() += tx.value;
+
+    // Reserved addresses are not persisted, so the destination is the only account written
+    Account current = account ? *account : Account{};
+    current.balance += tx.value;
+    state.update_account(*tx.to, account, current);
+
+    state.gc(gc_rows_per_tx, true);
+
+    send_tx_events(batch, txn);
+    LOGTIME("EVM END DEPOSIT");
+}
+
+runtime_config evm_contract::pushtx_runtime_config() {
     // Use default runtime configuration parameters.
     runtime_config rc;
 
@@ -566,6 +705,37 @@ void evm_contract::pushtx(eosio::name miner, bytes rlptx, eosio::binary_extensio
         rc.enforce_chain_id = false;
         rc.allow_non_self_miner = false;
     }
+    return rc;
+}
+
+namespace {
+
+// Returns the serialized bytes at the stream position without copying them. The dispatcher
+// reads the action data into a writable buffer of its own, which outlives the action.
+std::pair<char*, size_t> read_bytes_in_place(eosio::datastream<const char*>& ds) {
+    eosio::unsigned_int size;
+    ds >> size;
+    eosio::check(size.value <= ds.remaining(), "datastream attempted to read past the end");
+    auto data = const_cast<char*>(ds.pos());
+    ds.skip(size.value);
+    return {data, size.value};
+}
+
+} // namespace
+
+void evm_contract::pushtx(eosio::name miner, eosio::ignore<bytes>, eosio::ignore<eosio::binary_extension<uint64_t>>) {
+    LOGTIME("EVM START0");
+    assert_unfrozen();
+
+    auto& ds = get_datastream();
+    auto [rlptx, rlptx_size] = read_bytes_in_place(ds);
+    eosio::binary_extension<uint64_t> min_inclusion_price;
+    ds >> min_inclusion_price;
+
+    auto evm_version = _config->get_evm_version();
+    if (evm_version >= 1) _config->process_price_queue();
+
+    auto rc = pushtx_runtime_config();
 
     std::optional<uint64_t> min_inclusion_price_;
     if (min_inclusion_price.has_value()) {
@@ -573,7 +743,55 @@ void evm_contract::pushtx(eosio::name miner, bytes rlptx, eosio::binary_extensio
         check(evm_version >= 1, "min_inclusion_price requires evm_version >= 1");
     }
 
-    process_tx(rc, miner, transaction{std::move(rlptx)}, min_inclusion_price_);
+    [[maybe_unused]] auto stats = process_tx(rc, miner, transaction{rlptx, rlptx_size}, min_inclusion_price_);
+#ifdef WITH_TX_STATS
+    auto stats_bin = eosio::pack(stats);
+    set_action_return_value(stats_bin.data(), stats_bin.size());
+#endif
+}
+
+void evm_contract::pushtxs(eosio::name miner, eosio::ignore<std::vector<bytes>>, eosio::ignore<eosio::binary_extension<uint64_t>>) {
+    LOGTIME("EVM START0");
+    assert_unfrozen();
+
+    auto& ds = get_datastream();
+    eosio::unsigned_int count;
+    ds >> count;
+    eosio::check(count.value > 0, "no transactions");
+    std::vector<std::pair<char*, size_t>> rlptxs;
+    rlptxs.reserve(count.value);
+    for (uint32_t i = 0; i < count.value; ++i) {
+        rlptxs.push_back(read_bytes_in_place(ds));
+    }
+    eosio::binary_extension<uint64_t> min_inclusion_price;
+    ds >> min_inclusion_price;
+
+    auto evm_version = _config->get_evm_version();
+    if (evm_version >= 1) _config->process_price_queue();
+
+    auto rc = pushtx_runtime_config();
+
+    std::optional<uint64_t> min_inclusion_price_;
+    if (min_inclusion_price.has_value()) {
+        min_inclusion_price_ = *min_inclusion_price;
+        check(evm_version >= 1, "min_inclusion_price requires evm_version >= 1");
+    }
+
+    auto batch = begin_batch();
+#ifdef WITH_TX_STATS
+    std::vector<tx_stats> stats;
+    stats.reserve(rlptxs.size());
+#endif
+    for (auto [rlptx, rlptx_size] : rlptxs) {
+        [[maybe_unused]] auto tx_stat = process_tx(*batch, rc, miner, transaction{rlptx, rlptx_size}, min_inclusion_price_);
+#ifdef WITH_TX_STATS
+        stats.push_back(tx_stat);
+#endif
+    }
+#ifdef WITH_TX_STATS
+    auto stats_bin = eosio::pack(stats);
+    set_action_return_value(stats_bin.data(), stats_bin.size());
+#endif
 }
 
 void evm_contract::open(eosio::name owner) {
@@ -663,30 +881,38 @@ void evm_contract::handle_evm_transfer(eosio::asset quantity, const std::string&
     const std::optional<Bytes> address_bytes = from_hex(memo);
     eosio::check(!!address_bytes, "unable to parse destination address");
 
-    intx::uint256 value((uint64_t)quantity.amount);
-    value *= intx::uint256(_config->get_minimum_natively_representable());
+    std::unique_ptr<tx_batch> batch;
+    if (_config->get_evm_version_and_maybe_promote() >= 1) batch = begin_batch();
 
-    auto calculate_gas_limit = [&](const evmc::address& destination) -> int64_t {
-        int64_t gas_limit = 21000;
+    std::optional<balance_ledger> ledger;
+    bridge_deposit(batch.get(), ledger, quantity, to_evmc_address(*address_bytes));
+    if (ledger) ledger->flush();
+}
 
-        account_table accounts(get_self(), get_self().value);
-        auto inx = accounts.get_index<"by.address"_n>();
-        auto itr = inx.find(make_key(destination));
+void evm_contract::bridge_deposit(tx_batch* batch, std::optional<balance_ledger>& ledger, const eosio::asset& quantity, const evmc::address& destination) {
+    intx::uint256 value((uint64_t)quantity.amount);
+    value *= intx::uint256(_config->get_minimum_natively_representable());
 
-        if(itr == inx.end()) {
-            gas_limit += std::visit([&](const auto &v) { return v.gas_parameter.gas_txnewaccount; }, _config->get_consensus_param());
-        }
+    // Looked up through state so that accounts in either account table are found
+    std::optional<Account> account;
+    if (batch) {
+        account = batch->state.read_account(destination);
+    } else {
+        account = evm_runtime::state{get_self(), get_self(), true, true, _config->use_fixed_rows()}.read_account(destination);
+    }
 
-        return gas_limit;
-    };
+    int64_t gas_limit = 21000;
+    if (!account) {
+        gas_limit += std::visit([&](const auto &v) { return v.gas_parameter.gas_txnewaccount; }, _config->get_consensus_param());
+    }
 
     Transaction txn;
     txn.type = TransactionType::kLegacy;
     txn.nonce = get_and_increment_nonce(get_self());
     txn.max_priority_fee_per_gas = _config->get_gas_price();
     txn.max_fee_per_gas = _config->get_gas_price();
-    txn.to = to_evmc_address(*address_bytes);
-    txn.gas_limit = calculate_gas_limit(*txn.to);
+    txn.to = destination;
+    txn.gas_limit = gas_limit;
     txn.value = value;
     txn.r = 0u;  // r == 0 is pseudo signature that resolves to reserved address range
     txn.s = get_self().value;
@@ -697,16 +923,29 @@ void evm_contract::handle_evm_transfer(eosio::asset quantity, const std::string&
     rc.enforce_chain_id = false;
     rc.allow_non_self_miner = false;
 
-    dispatch_tx(rc, transaction{std::move(txn)});
+    if (!batch) {
+        dispatch_tx(rc, transaction{std::move(txn)});
+    } else if (can_fast_deposit(*batch, destination, account)) {
+        if (!ledger) ledger.emplace(get_self());
+        process_deposit(*batch, transaction{std::move(txn)}, std::move(account), *ledger);
+    } else {
+        // process_tx keeps its own ledger, ours must not hold cached rows across it
+        if (ledger) {
+            ledger->flush();
+            ledger.reset();
+        }
+        process_tx(*batch, rc, get_self(), transaction{std::move(txn)}, {} /* min_inclusion_price */);
+    }
 }
 
 void evm_contract::transfer(eosio::name from, eosio::name to, eosio::asset quantity, std::string memo) {
-    assert_unfrozen();
-    
-    // Allow transfer non-EOS tokens out.
+    // Allow transfer non-EOS tokens out. Checked before anything touches config so that
+    // notifications for transfers not aimed at us stay cheap.
     if(to != get_self() || from == get_self())
         return;
 
+    assert_unfrozen();
+
     eosio::check(get_code() == _config->get_token_contract() && quantity.symbol == _config->get_token_symbol(), "received unexpected token");
 
     if(memo.size() == 42 && memo[0] == '0' && memo[1] == 'x')
@@ -733,6 +972,70 @@ void evm_contract::withdraw(eosio::name owner, eosio::asset quantity, const eosi
     transfer_act.send(get_self(), to.has_value() ? *to : owner, quantity, std::string("Withdraw from EVM balance"));
 }
 
+void evm_contract::withdrawmany(const std::vector<withdraw_request>& withdrawals) {
+    assert_unfrozen();
+    check(!withdrawals.empty(), "no withdrawals");
+
+    // Rows are written once per owner and transfers are merged per recipient
+    balance_ledger ledger{get_self()};
+    std::map<eosio::name, eosio::asset> transfers;
+    for (const auto& w : withdrawals) {
+        require_auth(w.owner);
+        check(w.quantity.amount > 0, "must withdraw positive quantity");
+
+        auto& owner_balance = ledger.get(w.owner, "account is not open");
+        check(owner_balance.balance.amount >= w.quantity.amount, "overdrawn balance");
+        owner_balance.balance -= w.quantity;
+
+        const eosio::name to = w.to.value_or(w.owner);
+        auto [itr, inserted] = transfers.try_emplace(to, w.quantity);
+        if (!inserted) itr->second += w.quantity;
+    }
+    ledger.flush();
+
+    token::transfer_action transfer_act(_config->get_token_contract(), {{get_self(), "active"_n}});
+    for (const auto& [to, quantity] : transfers) {
+        transfer_act.send(get_self(), to, quantity, std::string("Withdraw from EVM balance"));
+    }
+}
+
+void evm_contract::depositmany(eosio::name from, const std::vector<deposit_request>& deposits) {
+    assert_unfrozen();
+    require_auth(from);
+    check(!deposits.empty(), "no deposits");
+
+    if(_config->get_evm_version() >= 1) _config->process_price_queue();
+
+    eosio::asset total(0, _config->get_token_symbol());
+    for (const auto& d : deposits) {
+        check(d.address.size() == sizeof(evmc::address), "invalid address");
+        check(d.quantity.amount > 0, "must deposit positive quantity");
+        total += d.quantity;
+    }
+
+    // Move the whole amount from the balance of `from` to the contract's balance, every
+    // deposit then pulls from it as a 0x memo transfer would
+    {
+        balance_ledger ledger{get_self()};
+        auto& from_balance = ledger.get(from, "account is not open");
+        check(from_balance.balance.amount >= total.amount, "overdrawn balance");
+        from_balance.balance -= total;
+        ledger.get(get_self(), "unable to find key").balance += total;
+        ledger.flush();
+    }
+
+    std::unique_ptr<tx_batch> batch;
+    if (_config->get_evm_version_and_maybe_promote() >= 1) batch = begin_batch();
+
+    std::optional<balance_ledger> ledger;
+    for (const auto& d : deposits) {
+        auto quantity = d.quantity - _config->get_ingress_bridge_fee();
+        eosio::check(quantity.amount > 0, "must bridge more than ingress bridge fee");
+        bridge_deposit(batch.get(), ledger, quantity, to_address(d.address));
+    }
+    if (ledger) ledger->flush();
+}
+
 bool evm_contract::gc(uint32_t max) {
     assert_unfrozen();
     require_auth(get_self());
@@ -817,7 +1120,7 @@ void evm_contract::admincall(const bytes& from, const bytes& to, const bytes& va
         nonce = get_and_increment_nonce(eosio::name(*eos_acct));
     }
     else {
-        evm_runtime::state state{get_self(), get_self(), true};
+        evm_runtime::state state{get_self(), get_self(), true, true, _config->use_fixed_rows()};
         auto account = state.read_account(from_addr);
         check(!!account, err_msg_invalid_addr);
         nonce = account->nonce;
@@ -888,6 +1191,12 @@ void evm_contract::setversion(uint64_t version) {
     _config->set_evm_version(version);
 }
 
+void evm_contract::usefixedrows() {
+    require_auth(get_self());
+    assert_inited();
+    _config->enable_fixed_rows();
+}
+
 void evm_contract::updtgasparam(eosio::asset ram_price_mb, uint64_t gas_price) {
     require_auth(get_self());
     _config->update_consensus_parameters(ram_price_mb, gas_price);
@@ -19,8 +19,30 @@ namespace evm_runtime {
     auto inx = db.get_index<"by.key"_n>();
     auto itr = inx.find(make_key(key));
 
+    storage_v2_table db2(get_self(), account_id);
+    uint64_t free_id;
+    auto itr2 = find_slot(db2, make_key(key), free_id);
+
+    // Slots are written to the table of the account's own layout, which is the one read_storage looks at.
+    // As in state::update_storage, a v2 account moves a slot out of the legacy table on first write.
+    account_v2_table accounts_v2(get_self(), get_self().value);
+    bool use_v2 = accounts_v2.find(account_id) != accounts_v2.end();
+
     if(value.has_value()) {
-        if(itr == inx.end()) {
+        if(use_v2) {
+            if(itr2 == db2.end()) {
+                if(itr != inx.end()) inx.erase(itr);
+                db2.emplace(get_self(), [&](auto& row){
+                    row.id = free_id;
+                    row.key = make_key(key);
+                    row.value = make_key(value.value());
+                });
+            } else {
+                db2.modify(*itr2, eosio::same_payer, [&](auto& row){
+                    row.value = make_key(value.value());
+                });
+            }
+        } else if(itr == inx.end()) {
             db.emplace(get_self(), [&](auto& row){
                 row.id = db.available_primary_key();
                 row.key = key;
@@ -31,6 +53,8 @@ namespace evm_runtime {
                 row.value = value.value();
             });
         }
+    } else if(itr2 != db2.end()) {
+        erase_slot(db2, itr2, get_self());
     } else {
         eosio::check(itr != inx.end(), "key not found");
         db.erase(*itr);
@@ -39,54 +63,76 @@ namespace evm_runtime {
 
 [[eosio::action]] void evm_contract::rmaccount(uint64_t id) {
     eosio::require_auth(get_self());
-    account_table accounts(get_self(), get_self().value);
-    auto itr = accounts.find(id);
-    eosio::check(itr != accounts.end(), "account not found");
 
-    if (itr->code_id) {
-        account_code_table codes(get_self(), get_self().value);
-        const auto& itrc = codes.get(itr->code_id.value(), "code not found");
-        if(itrc.ref_count-1) {
-            codes.modify(itrc, eosio::same_payer, [&](auto& row){
-                row.ref_count--;
-            });
-        } else {
-            codes.erase(itrc);
+    auto remove = [&](auto& accounts, const auto& row) {
+        if (row.code_id) {
+            account_code_table codes(get_self(), get_self().value);
+            const auto& itrc = codes.get(row.code_id.value(), "code not found");
+            if(itrc.ref_count-1) {
+                codes.modify(itrc, eosio::same_payer, [&](auto& r){
+                    r.ref_count--;
+                });
+            } else {
+                codes.erase(itrc);
+            }
         }
-    }
 
-    gc_store_table gc(get_self(), get_self().value);
-    gc.emplace(get_self(), [&](auto& row){
-        row.id = gc.available_primary_key();
-        row.storage_id = itr->id;
-    });
+        gc_store_table gc(get_self(), get_self().value);
+        gc.emplace(get_self(), [&](auto& r){
+            r.id = gc.available_primary_key();
+            r.storage_id = row.id;
+        });
 
-    accounts.erase(*itr);
-}
+        accounts.erase(row);
+    };
+
+    account_v2_table accounts_v2(get_self(), get_self().value);
+    auto itr2 = accounts_v2.find(id);
+    if(itr2 != accounts_v2.end()) {
+        remove(accounts_v2, *itr2);
+        return;
+    }
 
-[[eosio::action]] void evm_contract::addevmbal(uint64_t id, const bytes& delta, bool subtract) {
-    eosio::require_auth(get_self());
     account_table accounts(get_self(), get_self().value);
     auto itr = accounts.find(id);
     eosio::check(itr != accounts.end(), "account not found");
+    remove(accounts, *itr);
+}
 
-    inevm_singleton inevm(get_self(), get_self().value);
-    auto d = to_uint256(delta);
+[[eosio::action]] void evm_contract::addevmbal(uint64_t id, const bytes& delta, bool subtract) {
+    eosio::require_auth(get_self());
 
-    intx::result_with_carry<intx::uint256> res;
-    if(subtract) {
-        inevm.set(inevm.get()-=d, eosio::same_payer);
-        res = intx::subc(to_uint256(itr->balance), d);
-        eosio::check(!res.carry, "underflow detected");
-    } else {
-        res = intx::addc(to_uint256(itr->balance), d);
-        eosio::check(!res.carry, "overflow detected");
-        inevm.set(inevm.get()+=d, eosio::same_payer);
+    auto add = [&](auto& accounts, const auto& row) {
+        inevm_singleton inevm(get_self(), get_self().value);
+        auto d = to_uint256(delta);
+
+        intx::result_with_carry<intx::uint256> res;
+        if(subtract) {
+            inevm.set(inevm.get()-=d, eosio::same_payer);
+            res = intx::subc(to_uint256(row.balance), d);
+            eosio::check(!res.carry, "underflow detected");
+        } else {
+            res = intx::addc(to_uint256(row.balance), d);
+            eosio::check(!res.carry, "overflow detected");
+            inevm.set(inevm.get()+=d, eosio::same_payer);
+        }
+
+        accounts.modify(row, eosio::same_payer, [&](auto& r){
+            r.set_balance(res.value);
+        });
+    };
+
+    account_v2_table accounts_v2(get_self(), get_self().value);
+    auto itr2 = accounts_v2.find(id);
+    if(itr2 != accounts_v2.end()) {
+        add(accounts_v2, *itr2);
+        return;
     }
 
-    accounts.modify(*itr, eosio::same_payer, [&](auto& row){
-        row.balance = to_bytes(res.value);
-    });
+    account_table accounts(get_self(), get_self().value);
+    auto itr = accounts.find(id);
+    eosio::check(itr != accounts.end(), "account not found");
+    add(accounts, *itr);
 }
 
 [[eosio::action]] void evm_contract::addopenbal(name account, const bytes& delta, bool subtract) {
@@ -108,17 +154,27 @@ namespace evm_runtime {
 
 [[eosio::action]] void evm_contract::freezeaccnt(uint64_t id, bool value) {
     eosio::require_auth(get_self());
-    account_table accounts(get_self(), get_self().value);
-    auto itr = accounts.find(id);
-    eosio::check(itr != accounts.end(), "account not found");
 
-    accounts.modify(*itr, eosio::same_payer, [&](auto& row){
+    auto freeze = [&](auto& r){
         if(value) {
-            row.set_flag(account::flag::frozen);
+            r.set_flag(account::flag::frozen);
         } else {
-            row.clear_flag(account::flag::frozen);
+            r.clear_flag(account::flag::frozen);
         }
-    });
+    };
+
+    account_v2_table accounts_v2(get_self(), get_self().value);
+    auto itr2 = accounts_v2.find(id);
+    if(itr2 != accounts_v2.end()) {
+        accounts_v2.modify(*itr2, eosio::same_payer, freeze);
+        return;
+    }
+
+    account_table accounts(get_self(), get_self().value);
+    auto itr = accounts.find(id);
+    eosio::check(itr != accounts.end(), "account not found");
+
+    accounts.modify(*itr, eosio::same_payer, freeze);
 }
 
 }
@@ -0,0 +1,47 @@
+#include <eosio/check.hpp>
+#include <evmone/baseline_instruction_table.hpp>
+#include <evmone/instructions_traits.hpp>
+
+// Replaces evmone's baseline_instruction_table.cpp when built WITH_TRIMMED_REVISIONS.
+//
+// evmone keeps a cost table for every revision from Frontier to the latest one, plus a second set
+// for EOF code. EOS EVM only executes Istanbul (evm_version 0) up to Shanghai (evm_version 1 and
+// later), where EOF is not enabled, so only those legacy tables are kept. Looking up any other
+// revision aborts the action instead of executing with the wrong costs.
+namespace evmone::baseline
+{
+namespace
+{
+constexpr auto first_revision = EVMC_ISTANBUL;
+constexpr auto last_revision = EVMC_SHANGHAI;
+
+constexpr auto cost_tables = []() noexcept {
+    std::array<CostTable, last_revision - first_revision + 1> tables{};
+    for (size_t r = first_revision; r <= last_revision; ++r)
+    {
+        auto& table = tables[r - first_revision];
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = instr::gas_costs[r][i];  // Include instr::undefined in the table.
+    }
+    return tables;
+}();
+
+const CostTable& lookup(evmc_revision rev) noexcept
+{
+    eosio::check(rev >= first_revision && rev <= last_revision, "evm revision not included in this build");
+    return cost_tables[rev - first_revision];
+}
+}  // namespace
+
+const CostTable& get_baseline_cost_table(evmc_revision rev) noexcept
+{
+    return lookup(rev);
+}
+
+// Overload taking the EOF version of the code, only legacy code (version 0) is supported
+const CostTable& get_baseline_cost_table(evmc_revision rev, uint8_t eof_version) noexcept
+{
+    eosio::check(eof_version == 0, "EOF code not included in this build");
+    return lookup(rev);
+}
+}  // namespace evmone::baseline
@@ -5,10 +5,53 @@
 namespace evm_runtime {
 
 config_wrapper::config_wrapper(eosio::name self) : _self(self), _config(self, self.value) {
-    _exists = _config.exists();
-    if(_exists) {
-        _cached_config = _config.get();
+}
+
+config& config_wrapper::hot()const {
+    if(_hot_loaded) {
+        return _cached_config;
+    }
+    _hot_loaded = true;
+
+    // Same row the singleton reads, but without deserializing it as a whole
+    auto itr = eosio::internal_use_do_not_use::db_find_i64(_self.value, _self.value, "config"_n.value, "config"_n.value);
+    if(itr < 0) {
+        return _cached_config;
+    }
+    _exists = true;
+
+    auto size = eosio::internal_use_do_not_use::db_get_i64(itr, nullptr, 0);
+    _raw.resize(size);
+    eosio::internal_use_do_not_use::db_get_i64(itr, _raw.data(), size);
+
+    eosio::datastream<const char*> ds(_raw.data(), _raw.size());
+    ds >> _cached_config.version;
+    ds >> _cached_config.chainid;
+    ds >> _cached_config.genesis_time;
+    ds >> _cached_config.ingress_bridge_fee;
+    ds >> _cached_config.gas_price;
+    ds >> _cached_config.miner_cut;
+    ds >> _cached_config.status;
+    _cold_offset = ds.tellp();
+
+    return _cached_config;
+}
+
+config& config_wrapper::cold()const {
+    hot();
+    if(_cold_loaded) {
+        return _cached_config;
     }
+    _cold_loaded = true;
+
+    eosio::datastream<const char*> ds(_raw.data() + _cold_offset, _raw.size() - _cold_offset);
+    ds >> _cached_config.evm_version;
+    ds >> _cached_config.consensus_parameter;
+    ds >> _cached_config.token_contract;
+    ds >> _cached_config.queue_front_block;
+    ds >> _cached_config.gas_prices;
+    _raw.clear();
+
     if (!_cached_config.evm_version.has_value()) {
         _cached_config.evm_version = value_promoter_evm_version_type{};
         // Don't set dirty because action can be read-only.
@@ -27,6 +70,7 @@ config_wrapper::config_wrapper(eosio::name self) : _self(self), _config(self, se
     if (!_cached_config.gas_prices.has_value()) {
         _cached_config.gas_prices = gas_prices_type{};
     }
+    return _cached_config;
 }
 
 config_wrapper::~config_wrapper() {
@@ -37,67 +81,68 @@ void config_wrapper::flush() {
     if(!is_dirty()) {
         return;
     }
-    _config.set(_cached_config, _self);
+    _config.set(cold(), _self);
     clear_dirty();
     _exists = true;
 }
 
-bool config_wrapper::exists() {
+bool config_wrapper::exists()const {
+    hot();
     return _exists;
 }
 
 eosio::unsigned_int config_wrapper::get_version()const { 
-    return _cached_config.version;
+    return hot().version;
 }
 
 void config_wrapper::set_version(const eosio::unsigned_int version) {
-    _cached_config.version = version;
+    hot().version = version;
     set_dirty();
 }
 
 uint64_t config_wrapper::get_chainid()const {
-    return _cached_config.chainid;
+    return hot().chainid;
 }
 
 void config_wrapper::set_chainid(uint64_t chainid) {
-    _cached_config.chainid = chainid;
+    hot().chainid = chainid;
     set_dirty();
 }
 
 const eosio::time_point_sec& config_wrapper::get_genesis_time()const {
-    return _cached_config.genesis_time;
+    return hot().genesis_time;
 }
 
 void config_wrapper::set_genesis_time(eosio::time_point_sec genesis_time) {
-    _cached_config.genesis_time = genesis_time;
+    hot().genesis_time = genesis_time;
     set_dirty();
 }
 
 const eosio::asset& config_wrapper::get_ingress_bridge_fee()const {
-    return _cached_config.ingress_bridge_fee;
+    return hot().ingress_bridge_fee;
 }
 
 void config_wrapper::set_ingress_bridge_fee(const eosio::asset& ingress_bridge_fee) {
     eosio::check(evm_precision >= ingress_bridge_fee.symbol.precision(), "invalid ingress fee precision");
-    _cached_config.ingress_bridge_fee = ingress_bridge_fee;
+    hot().ingress_bridge_fee = ingress_bridge_fee;
     set_dirty();
 }
 
 uint64_t config_wrapper::get_gas_price()const {
-    return _cached_config.gas_price;
+    return hot().gas_price;
 }
 
 void config_wrapper::set_gas_price(uint64_t gas_price) {
-    _cached_config.gas_price = gas_price;
+    hot().gas_price = gas_price;
     set_dirty();
 }
 
 gas_prices_type config_wrapper::get_gas_prices()const {
-    return *_cached_config.gas_prices;
+    return *cold().gas_prices;
 }
 
 void config_wrapper::set_gas_prices(const gas_prices_type& prices) {
-    _cached_config.gas_prices = prices;
+    cold().gas_prices = prices;
     set_dirty();
 }
 
@@ -126,7 +171,7 @@ void config_wrapper::enqueue(Func&& update_fnc) {
         update_fnc(el);
     });
 
-    if( _cached_config.queue_front_block.value() == 0 ) {
+    if( cold().queue_front_block.value() == 0 ) {
         set_queue_front_block(activation_block_num);
     }
 }
@@ -144,7 +189,7 @@ void config_wrapper::enqueue_gas_prices(const gas_prices_type& prices) {
 }
 
 void config_wrapper::set_queue_front_block(uint32_t block_num) {
-    _cached_config.queue_front_block = block_num;
+    cold().queue_front_block = block_num;
     set_dirty();
 }
 
@@ -166,7 +211,7 @@ void config_wrapper::process_queue(Func&& update_func) {
     eosevm::block_mapping bm(get_genesis_time().sec_since_epoch());
     auto current_block_num = bm.timestamp_to_evm_block_num(get_current_time().time_since_epoch().count());
 
-    auto queue_front_block = _cached_config.queue_front_block.value();
+    auto queue_front_block = cold().queue_front_block.value();
     if( queue_front_block == 0 || current_block_num < queue_front_block ) {
         return;
     }
@@ -181,51 +226,80 @@ void config_wrapper::process_queue(Func&& update_func) {
 }
 
 uint32_t config_wrapper::get_miner_cut()const {
-    return _cached_config.miner_cut;
+    return hot().miner_cut;
 }
 
 void config_wrapper::set_miner_cut(uint32_t miner_cut) {
     eosio::check(miner_cut <= ninety_percent, "miner_cut must <= 90%");
-    _cached_config.miner_cut = miner_cut;
+    hot().miner_cut = miner_cut;
     set_dirty();
 }
 
 uint32_t config_wrapper::get_status()const {
-    return _cached_config.status;
+    return hot().status;
 }
 
 void config_wrapper::set_status(uint32_t status) {
-    _cached_config.status = status;
+    hot().status = status;
+    set_dirty();
+}
+
+bool config_wrapper::use_fixed_rows()const {
+    return (hot().status & static_cast<uint32_t>(status_flags::fixed_rows)) != 0;
+}
+
+void config_wrapper::enable_fixed_rows() {
+    eosio::check(get_evm_version() >= 1, "evm_version must >= 1");
+    eosio::check(!use_fixed_rows(), "fixed rows already enabled");
+    set_status(hot().status | static_cast<uint32_t>(status_flags::fixed_rows));
+
+    // New slots now take storage_slot_v2_bytes of RAM, charge gas_sset for that size from the next block on
+    eosio::check(cold().consensus_parameter.has_value(), "consensus_parameter not exist");
+    cold().consensus_parameter->update([&](auto& p) {
+        std::visit([&](auto& v){
+            intx::uint128 storage_gas = v.gas_parameter.gas_sset - gas_sset_min;
+            storage_gas = storage_gas * storage_slot_v2_bytes / storage_slot_bytes;
+            v.gas_parameter.gas_sset = gas_sset_min + static_cast<uint64_t>(storage_gas);
+        }, p);
+    }, hot().genesis_time, get_current_time());
     set_dirty();
 }
 
 uint64_t config_wrapper::get_evm_version()const {
-    // should not happen
-    eosio::check(_cached_config.evm_version.has_value(), "evm_version not exist");
-    return _cached_config.evm_version->get_value(_cached_config.genesis_time, get_current_time());
+    if(!_evm_version.has_value()) {
+        // should not happen
+        eosio::check(cold().evm_version.has_value(), "evm_version not exist");
+        _evm_version = cold().evm_version->get_value(hot().genesis_time, get_current_time());
+    }
+    return *_evm_version;
 }
 
 uint64_t config_wrapper::get_evm_version_and_maybe_promote() {
+    if(_evm_version_promoted) {
+        return *_evm_version;
+    }
     uint64_t current_version = 0;
     bool promoted = false;
-    if(_cached_config.evm_version.has_value()) {
-        std::tie(current_version, promoted) = _cached_config.evm_version->get_value_and_maybe_promote(_cached_config.genesis_time, get_current_time());
+    if(cold().evm_version.has_value()) {
+        std::tie(current_version, promoted) = cold().evm_version->get_value_and_maybe_promote(hot().genesis_time, get_current_time());
     }
     if(promoted) {
-        if(current_version >=1 && _cached_config.miner_cut != 0) _cached_config.miner_cut = 0;
+        if(current_version >=1 && hot().miner_cut != 0) hot().miner_cut = 0;
         set_dirty();
     }
+    _evm_version = current_version;
+    _evm_version_promoted = true;
     return current_version;
 }
 
 void config_wrapper::set_evm_version(uint64_t new_version) {
     eosio::check(new_version <= eosevm::max_eos_evm_version, "Unsupported version");
-    eosio::check(new_version != 3 || _cached_config.queue_front_block.value() == 0, "price queue must be empty");
+    eosio::check(new_version != 3 || cold().queue_front_block.value() == 0, "price queue must be empty");
     auto current_version = get_evm_version_and_maybe_promote();
     eosio::check(new_version > current_version, "new version must be greater than the active one");
-    _cached_config.evm_version->update([&](auto& v) {
+    cold().evm_version->update([&](auto& v) {
         v = new_version;
-    }, _cached_config.genesis_time, get_current_time());
+    }, hot().genesis_time, get_current_time());
     set_dirty();
 }
 
@@ -245,14 +319,14 @@ void config_wrapper::set_fee_parameters(const fee_parameters& fee_params,
     if (fee_params.miner_cut.has_value()) {
         eosio::check(get_evm_version() == 0, "can't set miner_cut");
         eosio::check(*fee_params.miner_cut <= ninety_percent, "miner_cut must <= 90%");
-        _cached_config.miner_cut = *fee_params.miner_cut;
+        hot().miner_cut = *fee_params.miner_cut;
     } else {
         eosio::check(allow_any_to_be_unspecified, "All required fee parameters not specified: missing miner_cut");
     }
 
     if (fee_params.ingress_bridge_fee.has_value()) {
-        if (_cached_config.ingress_bridge_fee.symbol != eosio::symbol()) {
-            eosio::check(fee_params.ingress_bridge_fee->symbol == _cached_config.ingress_bridge_fee.symbol, "bridge symbol can't change");
+        if (hot().ingress_bridge_fee.symbol != eosio::symbol()) {
+            eosio::check(fee_params.ingress_bridge_fee->symbol == hot().ingress_bridge_fee.symbol, "bridge symbol can't change");
         }
         eosio::check(fee_params.ingress_bridge_fee->amount >= 0, "ingress bridge fee cannot be negative");
 
@@ -272,7 +346,7 @@ void config_wrapper::update_consensus_parameters(eosio::asset ram_price_mb, uint
     eosio::check(ram_price_mb.symbol == get_token_symbol(), "invalid price symbol");
     eosio::check(gas_price > 0, "zero gas price is not allowed");
 
-    auto miner_cut = get_evm_version() >= 1 ? 0 : _cached_config.miner_cut;
+    auto miner_cut = get_evm_version() >= 1 ? 0 : hot().miner_cut;
 
     eosio::check(miner_cut < hundred_percent, "100% miner cut is not allowed");
 
@@ -282,9 +356,6 @@ void config_wrapper::update_consensus_parameters(eosio::asset ram_price_mb, uint
 
     double gas_per_byte_f = (ram_price_mb.amount / (1024.0 * 1024.0) * get_minimum_natively_representable()) / (gas_price * static_cast<double>(hundred_percent - miner_cut) / hundred_percent);
 
-    constexpr uint64_t account_bytes = 347;
-    constexpr uint64_t contract_fixed_bytes = 606;
-    constexpr uint64_t storage_slot_bytes = 346;
 
     eosio::check(gas_per_byte_f >= 0.0, "gas_per_byte must >= 0");
 
@@ -297,7 +368,7 @@ void config_wrapper::update_consensus_parameters(eosio::asset ram_price_mb, uint
                              account_bytes * gas_per_byte, /* gas_newaccount */
                              contract_fixed_bytes * gas_per_byte, /*gas_txcreate*/
                              gas_per_byte,/*gas_codedeposit*/
-                             gas_sset_min + storage_slot_bytes * gas_per_byte /*gas_sset*/
+                             gas_sset_min + storage_slot_bytes_for(use_fixed_rows()) * gas_per_byte /*gas_sset*/
     );
 
     if(get_evm_version() >= 1) {
@@ -312,9 +383,9 @@ void config_wrapper::update_consensus_parameters2(std::optional<uint64_t> gas_tx
     eosio::check(get_evm_version() >= 1, "evm_version must >= 1");
 
     // should not happen
-    eosio::check(_cached_config.consensus_parameter.has_value(), "consensus_parameter not exist");
+    eosio::check(cold().consensus_parameter.has_value(), "consensus_parameter not exist");
 
-    _cached_config.consensus_parameter->update([&](auto& p) {
+    cold().consensus_parameter->update([&](auto& p) {
         std::visit([&](auto& v){
             if (gas_txnewaccount.has_value()) v.gas_parameter.gas_txnewaccount = *gas_txnewaccount;
             if (gas_newaccount.has_value()) v.gas_parameter.gas_newaccount = *gas_newaccount;
@@ -325,26 +396,34 @@ void config_wrapper::update_consensus_parameters2(std::optional<uint64_t> gas_tx
                 v.gas_parameter.gas_sset = *gas_sset;
             }
         }, p);
-    }, _cached_config.genesis_time, get_current_time());
+    }, hot().genesis_time, get_current_time());
 
     set_dirty();
 }
 
 consensus_parameter_data_type config_wrapper::get_consensus_param() {
-    // should not happen
-    eosio::check(_cached_config.consensus_parameter.has_value(), "consensus_parameter not exist");
-    return _cached_config.consensus_parameter->get_value(_cached_config.genesis_time, get_current_time());
+    if(!_consensus_param.has_value()) {
+        // should not happen
+        eosio::check(cold().consensus_parameter.has_value(), "consensus_parameter not exist");
+        _consensus_param = cold().consensus_parameter->get_value(hot().genesis_time, get_current_time());
+    }
+    return *_consensus_param;
 }
 
 std::pair<consensus_parameter_data_type, bool> config_wrapper::get_consensus_param_and_maybe_promote() {
+    if(_consensus_param_promoted) {
+        return {*_consensus_param, false};
+    }
 
     // should not happen
-    eosio::check(_cached_config.consensus_parameter.has_value(), "consensus_parameter not exist");
+    eosio::check(cold().consensus_parameter.has_value(), "consensus_parameter not exist");
 
-    auto pair = _cached_config.consensus_parameter->get_value_and_maybe_promote(_cached_config.genesis_time, get_current_time());
+    auto pair = cold().consensus_parameter->get_value_and_maybe_promote(hot().genesis_time, get_current_time());
     if (pair.second) {
         set_dirty();
     }
+    _consensus_param = pair.first;
+    _consensus_param_promoted = true;
 
     return pair;
 }
@@ -369,19 +448,19 @@ time_point config_wrapper::get_current_time()const {
 }
 
 void config_wrapper::set_token_contract(eosio::name token_contract) {
-    _cached_config.token_contract = token_contract;
+    cold().token_contract = token_contract;
 }
 
 eosio::name config_wrapper::get_token_contract() const {
-    return *_cached_config.token_contract;
+    return *cold().token_contract;
 }
 
 eosio::symbol config_wrapper::get_token_symbol() const {
-    return _cached_config.ingress_bridge_fee.symbol;
+    return hot().ingress_bridge_fee.symbol;
 }
 
 uint64_t config_wrapper::get_minimum_natively_representable() const {
-    return pow10_const(evm_precision - _cached_config.ingress_bridge_fee.symbol.precision());
+    return pow10_const(evm_precision - hot().ingress_bridge_fee.symbol.precision());
 }
 
 bool config_wrapper::check_gas_overflow(uint64_t gas_txcreate, uint64_t gas_codedeposit) const {
@@ -0,0 +1,18 @@
+#include <ethash/keccak.h>
+#include <evm_runtime/intrinsics.hpp>
+
+// Replaces the WASM keccak.c entry points (renamed at build time, see CMakeLists.txt) so every
+// keccak256 in ethash, silkworm and evmone is computed natively by the host.
+extern "C" {
+
+union ethash_hash256 ethash_keccak256(const uint8_t* data, size_t size) noexcept {
+    union ethash_hash256 hash;
+    eosio::internal_use_do_not_use::sha3((const char*)data, size, (char*)hash.bytes, sizeof(hash.bytes), 1);
+    return hash;
+}
+
+union ethash_hash256 ethash_keccak256_32(const uint8_t data[32]) noexcept {
+    return ethash_keccak256(data, 32);
+}
+
+}
@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+// Replaces the global operator new/delete with size-class pools.
+//
+// CDT's malloc is a bump allocator whose free() never returns memory, so every node, journal
+// entry and buffer released during a transaction grows linear memory for good. Here freed blocks
+// go back to the free list of their class and are handed out again by later allocations of the
+// same transaction, or of the next one in a batch. Blocks over the largest class fall through to
+// malloc/free.
+//
+// Overhead per block is the header plus the rounding up to the class size:
+// - The header is 8 bytes: the class and the payload offset, 4 bytes each. That keeps payloads
+//   8 byte aligned. WASM loads and stores are correct at any alignment, so 16 bytes would only
+//   waste space.
+// - Classes are the powers of two from 16 bytes to 64KiB plus the midpoint above each one
+//   (16, 24, 32, 48, 64, 96, ...). A request is rounded up by at most a third of its size,
+//   instead of up to half with powers of two alone.
+// For example, a 40 byte map node takes 8 + 48 = 56 bytes. With a 16 byte header and power-of-two
+// classes it took 16 + 64 = 80. A 65 byte buffer now takes 8 + 96 = 104 bytes, down from 16 + 128 = 144.
+namespace {
+
+constexpr size_t   header_size   = 8;
+constexpr size_t   min_class_log = 4;   // 16 bytes
+constexpr size_t   num_classes   = 25;  // up to 64KiB
+constexpr uint32_t large_block   = 0xffffffff;
+
+struct header {
+    uint32_t size_class;
+    uint32_t offset; // from the start of the block to the payload
+};
+static_assert(sizeof(header) == header_size);
+
+struct free_block {
+    free_block* next;
+};
+
+free_block* free_lists[num_classes] = {};
+
+size_t class_size(uint32_t c) {
+    size_t base = size_t(1) << (c / 2 + min_class_log);
+    return c % 2 ? base + base / 2 : base;
+}
+
+uint32_t size_class(size_t size) {
+    uint32_t c = 0;
+    while (c < num_classes && class_size(c) < size) ++c;
+    return c < num_classes ? c : large_block;
+}
+
+// Blocks (pooled or from malloc) are at least 8 byte aligned, so alignments up to that need no padding
+void* pool_alloc(size_t size, size_t align = header_size) {
+    if (size == 0) size = 1;
+    size_t padding = align > header_size ? align - header_size : 0;
+    uint32_t c = size_class(size + padding);
+
+    char* block = nullptr;
+    if (c != large_block && free_lists[c]) {
+        block = reinterpret_cast<char*>(free_lists[c]);
+        free_lists[c] = free_lists[c]->next;
+    } else {
+        size_t payload = c == large_block ? size + padding : class_size(c);
+        block = static_cast<char*>(std::malloc(header_size + payload));
+        if (!block) return nullptr;
+    }
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(block) + header_size;
+    char* ptr = reinterpret_cast<char*>((start + align - 1) & ~uintptr_t(align - 1));
+    auto h = reinterpret_cast<header*>(ptr - header_size);
+    h->size_class = c;
+    h->offset = uint32_t(ptr - block);
+    return ptr;
+}
+
+void pool_free(void* ptr) {
+    if (!ptr) return;
+    auto h = reinterpret_cast<header*>(static_cast<char*>(ptr) - header_size);
+    uint32_t c = h->size_class;
+    char* block = static_cast<char*>(ptr) - h->offset;
+    if (c == large_block) {
+        std::free(block);
+        return;
+    }
+    auto fb = reinterpret_cast<free_block*>(block);
+    fb->next = free_lists[c];
+    free_lists[c] = fb;
+}
+
+} // namespace
+
+void* operator new(size_t size) { return pool_alloc(size); }
+void* operator new[](size_t size) { return pool_alloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return pool_alloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return pool_alloc(size); }
+void* operator new(size_t size, std::align_val_t align) { return pool_alloc(size, size_t(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return pool_alloc(size, size_t(align)); }
+
+void operator delete(void* ptr) noexcept { pool_free(ptr); }
+void operator delete[](void* ptr) noexcept { pool_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { pool_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { pool_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { pool_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { pool_free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { pool_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { pool_free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { pool_free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { pool_free(ptr); }
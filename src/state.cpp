@@ -7,26 +7,115 @@
 
 namespace evm_runtime {
 
-std::optional<Account> state::read_account(const evmc::address& address) const noexcept {    
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
+account_ref state::find_account(const evmc::address& address) const {
+    auto itr = addr2account.find(address);
+    if(itr != addr2account.end()) {
+        return itr->second;
+    }
 
-    if (itr == inx.end()) {
-        return {};
+    account_ref ref;
+    auto key = make_key(address);
+    if (use_fixed_rows()) {
+        auto inx = _accounts_v2.get_index<"by.address"_n>();
+        auto aitr = inx.find(key);
+        ++stats.account.read;
+        if (aitr != inx.end()) {
+            ref.v2 = &*aitr;
+        }
+    }
+
+    if (!ref) {
+        auto inx = _accounts.get_index<"by.address"_n>();
+        auto aitr = inx.find(key);
+        ++stats.account.read;
+        if (aitr != inx.end()) {
+            ref.v1 = &*aitr;
+        }
+    }
+
+    addr2account[address] = ref;
+    return ref;
+}
+
+storage_table& state::get_storage_table(uint64_t account_id) const {
+    auto itr = _storages.find(account_id);
+    if(itr == _storages.end()) {
+        itr = _storages.try_emplace(account_id, _self, account_id).first;
+    }
+    return itr->second;
+}
+
+storage_v2_table& state::get_storage_v2_table(uint64_t account_id) const {
+    auto itr = _storages_v2.find(account_id);
+    if(itr == _storages_v2.end()) {
+        itr = _storages_v2.try_emplace(account_id, _self, account_id).first;
+    }
+    return itr->second;
+}
+
+const account_v2& state::migrate_account(const evmc::address& address, const account& row) {
+    const auto& migrated = *_accounts_v2.emplace(_ram_payer, [&](auto& r){
+        r.id = row.id;
+        r.eth_address = to_checksum160(address);
+        r.nonce = row.nonce;
+        r.balance = make_key(row.get_balance());
+        r.code_id = row.code_id;
+        r.flags = row.flags.has_value() ? row.flags.value() : 0;
+        // Slots of this account are only moved to storage_v2_table when they are written
+        r.set_flag(account::flag::legacy_storage);
+    });
+    _accounts.erase(row);
+    ++stats.account.create;
+    ++stats.account.remove;
+    stats.ram_delta += int64_t(account_v2_bytes) - int64_t(account_bytes);
+    addr2account[address] = account_ref{nullptr, &migrated};
+    return migrated;
+}
+
+account_ref state::emplace_account(const evmc::address& address, uint64_t nonce, const uint256& balance, std::optional<uint64_t> code_id) {
+    account_ref ref;
+    if (use_fixed_rows()) {
+        ref.v2 = &*_accounts_v2.emplace(_ram_payer, [&](auto& row){
+            row.id = get_next_account_id();
+            row.eth_address = to_checksum160(address);
+            row.nonce = nonce;
+            row.set_balance(balance);
+            row.code_id = code_id;
+            row.flags = 0;
+        });
+    } else {
+        ref.v1 = &*_accounts.emplace(_ram_payer, [&](auto& row){
+            row.id = get_next_account_id();
+            row.eth_address = to_bytes(address);
+            row.nonce = nonce;
+            row.set_balance(balance);
+            row.code_id = code_id;
+            row.flags = 0;
+        });
     }
-    eosio::check(_allow_frozen || !itr->has_flag(account::flag::frozen), "account is frozen");
+    addr2account[address] = ref;
+    ++stats.account.create;
+    stats.ram_delta += ref.v2 ? account_v2_bytes : account_bytes;
+    return ref;
+}
 
-    addr2id[address] = itr->id;
+std::optional<Account> state::read_account(const evmc::address& address) const noexcept {
+    account_ref row = find_account(address);
+    if (!row) {
+        return {};
+    }
+    eosio::check(_allow_frozen || !row.has_flag(account::flag::frozen), "account is frozen");
 
     evmc::bytes32 code_hash;
-    if (itr->code_id) {
-        account_code_table codes(_self, _self.value);
-        auto citr = codes.find(itr->code_id.value());
-        if (citr != codes.end()) {
+    if (row.code_id()) {
+        auto citr = _codes.find(row.code_id().value());
+        if (citr != _codes.end()) {
             code_hash = to_bytes32(citr->code_hash);
-            addr2code[code_hash] = citr->code;
+            // Only the first lookup of a code row in this state reaches the table
+            if (hash2code.emplace(code_hash, &*citr).second) {
+                ++stats.code.read;
+                stats.code_bytes += citr->code.size();
+            }
         } else {
             // Should not reach here! 
             // Return empty hash for robustness.
@@ -36,55 +125,63 @@ std::optional<Account> state::read_account(const evmc::address& address) const n
         code_hash = silkworm::kEmptyHash;
     }
 
-    return Account{itr->nonce, intx::be::load<uint256>(itr->get_balance()), code_hash, 0};
+    return Account{row.nonce(), intx::be::load<uint256>(row.balance()), code_hash, 0};
 }
 
 ByteView state::read_code(const evmc::bytes32& code_hash) const noexcept {
     
-    if(addr2code.find(code_hash) != addr2code.end()) {
-        const auto& code = addr2code[code_hash];
-        return ByteView{(const uint8_t*)code.data(), code.size()};
-    }
-    
-    account_code_table codes(_self, _self.value);
-    auto inx = codes.get_index<"by.codehash"_n>();
-    auto itr = inx.find(make_key(code_hash));
-    
-    if (itr == inx.end() || itr->code.size() == 0) {
-        return ByteView{};
+    const account_code* row = nullptr;
+    auto hitr = hash2code.find(code_hash);
+    if(hitr != hash2code.end()) {
+        row = hitr->second;
+    } else {
+        auto inx = _codes.get_index<"by.codehash"_n>();
+        auto itr = inx.find(make_key(code_hash));
+        ++stats.code.read;
+        if (itr == inx.end()) {
+            return ByteView{};
+        }
+        row = &*itr;
+        hash2code[code_hash] = row;
+        stats.code_bytes += row->code.size();
     }
 
-    addr2code[code_hash] = itr->code;
-    const auto& code = addr2code[code_hash];
-    return ByteView{(const uint8_t*)code.data(), code.size()};
+    // Rows stay in the multi_index cache for the lifetime of the state, so no copy is needed
+    return ByteView{(const uint8_t*)row->code.data(), row->code.size()};
 }
 
 evmc::bytes32 state::read_storage(const evmc::address& address, uint64_t incarnation,
                                           const evmc::bytes32& location) const noexcept {
     
-    uint64_t account_id = 0;
-    if(addr2id.find(address) == addr2id.end()) {
-        account_table accounts(_self, _self.value);
-        auto inx = accounts.get_index<"by.address"_n>();
-        auto itr = inx.find(make_key(address));
-        ++stats.account.read;
-        if (itr == inx.end()) return {};
-        addr2id[address] = itr->id;
-    }
+    account_ref row = find_account(address);
+    if (!row) return {};
+
+    const auto slot = std::make_pair(row.id(), location);
+    if (missing_slots.count(slot)) return {};
 
-    account_id = addr2id[address];
+    if (row.v2) {
+        auto& db = get_storage_v2_table(row.id());
+        uint64_t free_id;
+        auto itr2 = find_slot(db, make_key(location), free_id);
+        ++stats.storage.read;
+        if(itr2 != db.end()) return itr2->get_value();
+        if(!row.v2->has_flag(account::flag::legacy_storage)) {
+            missing_slots.insert(slot);
+            return {};
+        }
+    }
 
-    storage_table db(_self, account_id);
+    auto& db = get_storage_table(row.id());
     auto inx2 = db.get_index<"by.key"_n>();
     auto itr2 = inx2.find(make_key(location));
     ++stats.storage.read;
     
-    if(itr2 == inx2.end()) return {};
-
-    evmc::bytes32 res;
-    std::copy(itr2->value.begin(), itr2->value.end(), res.bytes);
+    if(itr2 == inx2.end()) {
+        missing_slots.insert(slot);
+        return {};
+    }
 
-    return res;
+    return itr2->get_value();
 }
 
 uint64_t state::previous_incarnation(const evmc::address& address) const noexcept {
@@ -99,80 +196,93 @@ void state::update_account(const evmc::address& address, std::optional<Account>
     const bool equal{current == initial};
     if(equal) return;
     
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
-
-    auto emplace = [&](auto& row) {
-        row.id = get_next_account_id();
-        row.eth_address = to_bytes(address);
-        row.nonce = current->nonce;
-        row.balance = to_bytes(current->balance);
-        // Codes are not supposed to changed in this call.
-        row.code_id = std::nullopt;
-        row.flags = 0;
-    };
+    account_ref row = find_account(address);
 
-    auto update = [&](auto& row) {
-        row.nonce = current->nonce;
-        row.balance = to_bytes(current->balance);
+    auto update = [&](auto& r) {
+        r.nonce = current->nonce;
+        r.set_balance(current->balance);
         // Codes are not supposed to changed in this call.
     };
 
-    auto remove_account = [&](auto& itr) {
-        storage_table db(_self, itr->id);
+    auto remove_account = [&]() {
         // add to garbage collection table for later removal
         gc_store_table gc(_self, _self.value);
-        gc.emplace(_ram_payer, [&](auto& row){
-            row.id = gc.available_primary_key();
-            row.storage_id = itr->id;
+        auto gc_itr = gc.emplace(_ram_payer, [&](auto& r){
+            r.id = gc.available_primary_key();
+            r.storage_id = row.id();
         });
+        if (!_first_new_gc_id) _first_new_gc_id = gc_itr->id;
         // Remove code if necessary
-        if (itr->code_id) {
-            account_code_table codes(_self, _self.value);
-            const auto& itrc = codes.get(itr->code_id.value(), "code not found");
+        if (row.code_id()) {
+            const auto& itrc = _codes.get(row.code_id().value(), "code not found");
             if(itrc.ref_count-1) {
-                codes.modify(itrc, eosio::same_payer, [&](auto& row){
-                    row.ref_count--;
+                _codes.modify(itrc, eosio::same_payer, [&](auto& r){
+                    r.ref_count--;
                 });
             } else {
-                codes.erase(itrc);
+                hash2code.erase(to_bytes32(itrc.code_hash));
+                ++stats.code.remove;
+                stats.ram_delta -= contract_fixed_bytes + itrc.code.size();
+                _codes.erase(itrc);
             }
         }
-        accounts.erase(*itr);
+        addr2account[address] = account_ref{};
+        ++stats.account.remove;
+        if (row.v2) {
+            stats.ram_delta -= account_v2_bytes;
+            _accounts_v2.erase(*row.v2);
+        } else {
+            stats.ram_delta -= account_bytes;
+            _accounts.erase(*row.v1);
+        }
     };
 
-
     if (current.has_value()) {
-        if (itr == inx.end()) {
-            accounts.emplace(_ram_payer, emplace);
-            ++stats.account.create;
+        if (!row) {
+            // Codes are not supposed to changed in this call.
+            emplace_account(address, current->nonce, current->balance, std::nullopt);
         } else {
             if( initial && initial->incarnation != current->incarnation ) {
-                remove_account(itr);
-                accounts.emplace(_ram_payer, emplace);
+                remove_account();
+                emplace_account(address, current->nonce, current->balance, std::nullopt);
             } else {
-                accounts.modify(*itr, eosio::same_payer, update);
+                if (row.v1 && use_fixed_rows()) {
+                    row = account_ref{nullptr, &migrate_account(address, *row.v1)};
+                }
+                if (row.v2) {
+                    _accounts_v2.modify(*row.v2, eosio::same_payer, update);
+                } else {
+                    _accounts.modify(*row.v1, eosio::same_payer, update);
+                }
                 ++stats.account.update;
             }
         }
     } else {
-        if(itr != inx.end()) {
-            remove_account(itr);
-            ++stats.account.remove;
+        if(row) {
+            remove_account();
         }
     }
 }
 
-bool state::gc(uint32_t max) {
+bool state::gc(uint32_t max, bool skip_new) {
     gc_store_table gc(_self, _self.value);
     auto i = gc.begin();
     while( max && i != gc.end() ) {
-        storage_table db(_self, i->storage_id);
+        if( skip_new && _first_new_gc_id && i->id >= *_first_new_gc_id ) break;
+        auto& db = get_storage_table(i->storage_id);
         auto sitr = db.begin();
         while( max && sitr != db.end() ) {
             sitr = db.erase(sitr);
+            ++stats.storage.remove;
+            stats.ram_delta -= storage_slot_bytes;
+            --max;
+        }
+        auto& db2 = get_storage_v2_table(i->storage_id);
+        auto sitr2 = db2.begin();
+        while( max && sitr2 != db2.end() ) {
+            sitr2 = db2.erase(sitr2);
+            ++stats.storage.remove;
+            stats.ram_delta -= storage_slot_v2_bytes;
             --max;
         }
         if( !max ) break;
@@ -185,43 +295,55 @@ bool state::gc(uint32_t max) {
 
 void state::update_account_code(const evmc::address& address, uint64_t, const evmc::bytes32& code_hash, ByteView code) {
     check(!_read_only, "ro state");
-    account_code_table codes(_self, _self.value);
-    auto inxc = codes.get_index<"by.codehash"_n>();
-    auto itrc = inxc.find(make_key(code_hash));
+    const account_code* existing = nullptr;
+    auto hitr = hash2code.find(code_hash);
+    if(hitr != hash2code.end()) {
+        existing = hitr->second;
+    } else {
+        auto inxc = _codes.get_index<"by.codehash"_n>();
+        auto itrc = inxc.find(make_key(code_hash));
+        ++stats.code.read;
+        if(itrc != inxc.end()) {
+            existing = &*itrc;
+            stats.code_bytes += existing->code.size();
+        }
+    }
     uint64_t code_id;
-    if(itrc == inxc.end()) {
-        code_id = codes.available_primary_key();
-        codes.emplace(_ram_payer, [&](auto& row){
+    if(!existing) {
+        code_id = _codes.available_primary_key();
+        hash2code[code_hash] = &*_codes.emplace(_ram_payer, [&](auto& row){
             row.id = code_id;
             row.code_hash = to_bytes(code_hash);
             row.code = bytes{code.begin(), code.end()};
             row.ref_count = 1;
         });
+        ++stats.code.create;
+        stats.ram_delta += contract_fixed_bytes + code.size();
     } else {
         // code should be immutable
-        codes.modify(*itrc, eosio::same_payer, [&](auto& row){
+        _codes.modify(*existing, eosio::same_payer, [&](auto& row){
             row.ref_count++;
         });
-        code_id = itrc->id;
+        ++stats.code.update;
+        code_id = existing->id;
     }
     
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
-    if( itr != inx.end() ) {
-        accounts.modify(*itr, eosio::same_payer, [&](auto& row){
-            row.code_id = code_id;
-        });
+    account_ref row = find_account(address);
+    if( row ) {
+        if (row.v1 && use_fixed_rows()) {
+            row = account_ref{nullptr, &migrate_account(address, *row.v1)};
+        }
+        auto set_code = [&](auto& r){
+            r.code_id = code_id;
+        };
+        if (row.v2) {
+            _accounts_v2.modify(*row.v2, eosio::same_payer, set_code);
+        } else {
+            _accounts.modify(*row.v1, eosio::same_payer, set_code);
+        }
         ++stats.account.update;
     } else {
-        accounts.emplace(_ram_payer, [&](auto& row){
-            row.id = get_next_account_id();;
-            row.eth_address = to_bytes(address);
-            row.nonce = 0;
-            row.code_id = code_id;
-        });
-        ++stats.account.create;
+        emplace_account(address, 0, 0, code_id);
     }
 }
 
@@ -229,52 +351,92 @@ void state::update_storage(const evmc::address& address, uint64_t incarnation, c
                                    const evmc::bytes32& initial, const evmc::bytes32& current) {
     
     check(!_read_only, "ro state");
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(address));
-    ++stats.account.read;
+    account_ref row = find_account(address);
+    const auto key = make_key(location);
 
-    if (is_zero(current)) {
-        if(itr == inx.end()) return;
-        storage_table db(_self, itr->id);
+    // Returns true if the slot was found (and erased) in the legacy table
+    auto erase_legacy_slot = [&]() {
+        auto& db = get_storage_table(row.id());
         auto inx2 = db.get_index<"by.key"_n>();
-        auto itr2 = inx2.find(make_key(location));
+        auto itr2 = inx2.find(key);
         ++stats.storage.read;
-        if(itr2 == inx2.end()) return;
+        if(itr2 == inx2.end()) return false;
         db.erase(*itr2);
         ++stats.storage.remove;
-    } else {
-        uint64_t table_id;
-        if(itr == inx.end()){
-            accounts.emplace(_ram_payer, [&](auto& row){
-                table_id = get_next_account_id();
-                row.id = table_id;
-                row.eth_address = to_bytes(address);
-                row.nonce = 0;
-                row.code_id = std::nullopt;
-            });
-            ++stats.account.read;
-        } else {
-            table_id = itr->id;
+        stats.ram_delta -= storage_slot_bytes;
+        return true;
+    };
+
+    if (is_zero(current)) {
+        if(!row) return;
+        if(!missing_slots.insert(std::make_pair(row.id(), location)).second) return;
+        if (row.v2) {
+            auto& db = get_storage_v2_table(row.id());
+            uint64_t free_id;
+            auto itr2 = find_slot(db, key, free_id);
+            ++stats.storage.read;
+            if(itr2 != db.end()) {
+                erase_slot(db, itr2, _ram_payer);
+                ++stats.storage.remove;
+                stats.ram_delta -= storage_slot_v2_bytes;
+                return;
+            }
+            if(!row.v2->has_flag(account::flag::legacy_storage)) return;
         }
+        erase_legacy_slot();
+        return;
+    }
 
-        storage_table db(_self, table_id);
-        auto inx2 = db.get_index<"by.key"_n>();
-        auto itr2 = inx2.find(make_key(location));
+    if(!row){
+        row = emplace_account(address, 0, 0, std::nullopt);
+    } else if (row.v1 && use_fixed_rows()) {
+        row = account_ref{nullptr, &migrate_account(address, *row.v1)};
+    }
+    missing_slots.erase(std::make_pair(row.id(), location));
+
+    if (row.v2) {
+        auto& db = get_storage_v2_table(row.id());
+        uint64_t free_id;
+        auto itr2 = find_slot(db, key, free_id);
         ++stats.storage.read;
-        if(itr2 == inx2.end()) {
-            db.emplace(_ram_payer, [&](auto& row){
-                row.id = db.available_primary_key();
-                row.key = to_bytes(location);
-                row.value = to_bytes(current);
+        if(itr2 == db.end()) {
+            // Move the slot out of the legacy table on first write
+            if(row.v2->has_flag(account::flag::legacy_storage)) {
+                erase_legacy_slot();
+            }
+            db.emplace(_ram_payer, [&](auto& r){
+                r.id = free_id;
+                r.key = key;
+                r.value = make_key(current);
             });
             ++stats.storage.create;
+            stats.ram_delta += storage_slot_v2_bytes;
         } else {
-            db.modify(*itr2, eosio::same_payer, [&](auto& row){
-                row.value = to_bytes(current);
+            db.modify(*itr2, eosio::same_payer, [&](auto& r){
+                r.value = make_key(current);
             });
             ++stats.storage.update;
         }
+        return;
+    }
+
+    auto& db = get_storage_table(row.id());
+    auto inx2 = db.get_index<"by.key"_n>();
+    auto itr2 = inx2.find(key);
+    ++stats.storage.read;
+    if(itr2 == inx2.end()) {
+        db.emplace(_ram_payer, [&](auto& r){
+            r.id = db.available_primary_key();
+            r.key = to_bytes(location);
+            r.value = to_bytes(current);
+        });
+        ++stats.storage.create;
+        stats.ram_delta += storage_slot_bytes;
+    } else {
+        db.modify(*itr2, eosio::same_payer, [&](auto& r){
+            r.value = to_bytes(current);
+        });
+        ++stats.storage.update;
     }
 }
 
@@ -337,8 +499,8 @@ uint64_t state::get_next_account_id() {
         if(cfg2.exists()) {
             _config2 = cfg2.get();
         } else {
-            account_table accounts(_self, _self.value);
-            _config2 = config2{accounts.available_primary_key()};
+            // Migrated rows keep their id, so the next id must be past both tables
+            _config2 = config2{std::max(_accounts.available_primary_key(), _accounts_v2.available_primary_key())};
         }
     }
     auto id = _config2->next_account_id;
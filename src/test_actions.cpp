@@ -6,6 +6,17 @@
 #include <evm_runtime/test/config.hpp>
 #include <evm_runtime/runtime_config.hpp>
 #include <evm_runtime/transaction.hpp>
+#include <evm_runtime/balance_ledger.hpp>
+#include <ethash/keccak.h>
+
+#ifdef WITH_HOST_KECCAK
+// keccak.c entry points, renamed when the host function takes their place (see host_keccak.cpp)
+extern "C" {
+union ethash_hash256 ethash_keccak256_wasm(const uint8_t* data, size_t size) noexcept;
+union ethash_hash256 ethash_keccak256_32_wasm(const uint8_t data[32]) noexcept;
+}
+#endif
+
 namespace evm_runtime {
 using namespace silkworm;
 
@@ -18,7 +29,7 @@ using namespace silkworm;
     block.header = bi.get_block_header();
 
     evm_runtime::test::engine engine{evm_runtime::test::kTestNetwork};
-    evm_runtime::state state{get_self(), get_self()};
+    evm_runtime::state state{get_self(), get_self(), false, true, _config->use_fixed_rows()};
     silkworm::ExecutionProcessor ep{block, engine, state, evm_runtime::test::kTestNetwork, {}};
 
     if(orlptx) {
@@ -32,7 +43,9 @@ using namespace silkworm;
             .enforce_chain_id = false,
             .allow_non_self_miner = true
         };
-        execute_tx(rc, eosio::name{}, block, transaction{std::move(tx)}, ep);
+        balance_ledger ledger{get_self()};
+        execute_tx(rc, eosio::name{}, block, transaction{std::move(tx)}, ep, ledger);
+        ledger.flush();
     }
     engine.finalize(ep.state(), ep.evm().block());
     ep.state().write_to_db(ep.evm().block().header.number);
@@ -43,10 +56,9 @@ using namespace silkworm;
 
     eosio::require_auth(get_self());
 
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(to_address(addy)));
-    if(itr == inx.end()) {
+    evm_runtime::state state{get_self(), get_self(), true, true, _config->use_fixed_rows()};
+    account_ref row = state.find_account(to_address(addy));
+    if(!row) {
         eosio::print("no data for: ");
         eosio::printhex(addy.data(), addy.size());
         eosio::print("\n");
@@ -57,16 +69,23 @@ using namespace silkworm;
     eosio::printhex(addy.data(), addy.size());
 
     uint64_t cnt=0;
-    storage_table db(_self, itr->id);
-    auto sitr = db.begin();
-    while(sitr != db.end()) {
+    auto& db = state.get_storage_table(row.id());
+    for(auto sitr = db.begin(); sitr != db.end(); ++sitr, ++cnt) {
         eosio::print("\n");
         eosio::printhex(sitr->key.data(), sitr->key.size());
         eosio::print(":");
         eosio::printhex(sitr->value.data(), sitr->value.size());
         eosio::print("\n");
-        ++sitr;
-        ++cnt;
+    }
+    auto& db2 = state.get_storage_v2_table(row.id());
+    for(auto sitr = db2.begin(); sitr != db2.end(); ++sitr, ++cnt) {
+        const auto key = to_bytes32(sitr->key);
+        const auto value = sitr->get_value();
+        eosio::print("\n");
+        eosio::printhex(key.bytes, sizeof(key.bytes));
+        eosio::print(":");
+        eosio::printhex(value.bytes, sizeof(value.bytes));
+        eosio::print("\n");
     }
 
     eosio::print(" = ", cnt, "\n");
@@ -77,45 +96,49 @@ using namespace silkworm;
 
     eosio::require_auth(get_self());
 
-    auto print_store = [](auto sitr) {
+    auto print_slot = [](const auto& key, const auto& value) {
         eosio::print("    ");
-        eosio::printhex(sitr->key.data(), sitr->key.size());
+        eosio::printhex(key.data(), key.size());
         eosio::print(":");
-        eosio::printhex(sitr->value.data(), sitr->value.size());
+        eosio::printhex(value.data(), value.size());
         eosio::print("\n");
     };
 
-    account_table accounts(_self, _self.value);
-    auto itr = accounts.begin();
+    // Slots of an account (or of a gc'ed storage id) can be in either storage table
+    auto print_storage = [&](uint64_t storage_id) {
+        storage_table db(_self, storage_id);
+        for(auto sitr = db.begin(); sitr != db.end(); ++sitr) {
+            print_slot(sitr->key, sitr->value);
+        }
+        storage_v2_table db2(_self, storage_id);
+        for(auto sitr = db2.begin(); sitr != db2.end(); ++sitr) {
+            print_slot(to_bytes(to_bytes32(sitr->key)), to_bytes(sitr->get_value()));
+        }
+    };
+
     eosio::print("DUMPALL start\n");
-    while( itr != accounts.end() ) {
+    account_table accounts(_self, _self.value);
+    for(auto itr = accounts.begin(); itr != accounts.end(); ++itr) {
         eosio::print("  account:");
         eosio::printhex(itr->eth_address.data(), itr->eth_address.size());
         eosio::print("\n");
-        storage_table db(_self, itr->id);
-        auto sitr = db.begin();
-        while( sitr != db.end() ) {
-            print_store( sitr );
-            sitr++;
-        }
-        
-        itr++;
+        print_storage(itr->id);
+    }
+    account_v2_table accounts_v2(_self, _self.value);
+    for(auto itr = accounts_v2.begin(); itr != accounts_v2.end(); ++itr) {
+        const auto address = itr->eth_address.extract_as_byte_array();
+        eosio::print("  account:");
+        eosio::printhex(address.data(), address.size());
+        eosio::print("\n");
+        print_storage(itr->id);
     }
     eosio::print("  gc:");
     gc_store_table gc(_self, _self.value);
-    auto i = gc.begin();
-    while( i != gc.end() ) {
+    for(auto i = gc.begin(); i != gc.end(); ++i) {
         eosio::print("   storage_id:");
         eosio::print(i->storage_id);
         eosio::print("\n");
-        storage_table db(_self, i->storage_id);
-        auto sitr = db.begin();
-        while( sitr != db.end() ) {
-            print_store( sitr );
-            ++sitr;
-        }
-
-        ++i;
+        print_storage(i->storage_id);
     }
 
     eosio::print("DUMPALL end\n");
@@ -149,6 +172,22 @@ using namespace silkworm;
         itr = accounts.erase(itr);
     }
 
+    account_v2_table accounts_v2(_self, _self.value);
+    auto itr2 = accounts_v2.begin();
+    while( itr2 != accounts_v2.end() ) {
+        storage_v2_table db(_self, itr2->id);
+        auto sitr = db.begin();
+        while( sitr != db.end() ) {
+            sitr = db.erase(sitr);
+        }
+        storage_table db1(_self, itr2->id);
+        auto sitr1 = db1.begin();
+        while( sitr1 != db1.end() ) {
+            sitr1 = db1.erase(sitr1);
+        }
+        itr2 = accounts_v2.erase(itr2);
+    }
+
     account_code_table codes(_self, _self.value);
     auto itrc = codes.begin();
     while(itrc != codes.end()) {
@@ -168,7 +207,7 @@ using namespace silkworm;
 
     eosio::require_auth(get_self());
 
-    evm_runtime::state state{get_self(), get_self()};
+    evm_runtime::state state{get_self(), get_self(), false, true, _config->use_fixed_rows()};
     auto bvcode = ByteView{(const uint8_t *)code.data(), code.size()};
     state.update_account_code(to_address(address), incarnation, to_bytes32(code_hash), bvcode);
 }
@@ -178,7 +217,7 @@ using namespace silkworm;
 
     eosio::require_auth(get_self());
 
-    evm_runtime::state state{get_self(), get_self()};
+    evm_runtime::state state{get_self(), get_self(), false, true, _config->use_fixed_rows()};
     eosio::print("updatestore: ");
     eosio::printhex(address.data(), address.size());
     eosio::print("\n   ");
@@ -195,7 +234,7 @@ using namespace silkworm;
 
     eosio::require_auth(get_self());
 
-    evm_runtime::state state{get_self(), get_self()};
+    evm_runtime::state state{get_self(), get_self(), false, true, _config->use_fixed_rows()};
     auto maybe_account = [](const bytes& data) -> std::optional<Account> {
         std::optional<Account> res{};
         if(data.size()) {
@@ -219,22 +258,13 @@ using namespace silkworm;
 
     eosio::require_auth(get_self());
 
-    account_table accounts(_self, _self.value);
-    auto inx = accounts.get_index<"by.address"_n>();
-    auto itr = inx.find(make_key(addy));
-
-    if(itr == inx.end()) {
-        accounts.emplace(get_self(), [&](auto& row){
-            row.id = accounts.available_primary_key();;
-            row.code_id = std::nullopt;
-            row.eth_address = addy;
-            row.balance = bal;
-        });
-    } else {
-        accounts.modify(*itr, eosio::same_payer, [&](auto& row){
-            row.balance = bal;
-        });
-    }
+    // Goes through state so an existing row is updated in whichever account table holds it
+    evm_runtime::state state{get_self(), get_self(), false, true, _config->use_fixed_rows()};
+    auto address = to_address(addy);
+    auto initial = state.read_account(address);
+    Account current = initial.value_or(Account{});
+    current.balance = to_uint256(bal);
+    state.update_account(address, initial, current);
 }
 
 [[eosio::action]] void evm_contract::testbaldust(const name test) {
@@ -378,4 +408,102 @@ using namespace silkworm;
     }
 }
 
+[[eosio::action]] void evm_contract::testrecover(const bytes& rlptx, const bytes& expected) {
+    transaction txn{rlptx};
+    silkworm::Transaction tx = txn.get_tx();
+
+    // The patched raw RLP must hash to the same signing payload silkworm encodes
+    Bytes preimage;
+    tx.encode_for_signing(preimage);
+    bytes raw{rlptx};
+    auto hash = signing_hash(raw.data(), raw.size(), tx);
+    eosio::check(hash.has_value() && *hash == silkworm::keccak256(preimage), "signing hash mismatch");
+    eosio::check(raw == rlptx, "rlptx not restored");
+
+    // Differential check of the host backend against silkworm's WASM recovery
+    auto host = recover_sender_host(tx, *hash);
+    tx.from.reset();
+    tx.recover_sender();
+
+    eosio::check(host == tx.from, "recovered senders differ");
+    eosio::check(host.has_value() && *host == to_address(expected), "unexpected sender");
+}
+
+[[eosio::action]] void evm_contract::testkeccak(const bytes& data, const bytes& expected) {
+    const auto* ptr = reinterpret_cast<const uint8_t*>(data.data());
+    auto hash = ethash_keccak256(ptr, data.size());
+
+#ifdef WITH_HOST_KECCAK
+    // Differential check of the host backend against the WASM implementation it replaces
+    auto wasm = ethash_keccak256_wasm(ptr, data.size());
+    eosio::check(std::equal(std::begin(hash.bytes), std::end(hash.bytes), std::begin(wasm.bytes)), "host and wasm keccak differ");
+    if(data.size() == 32) {
+        auto host32 = ethash_keccak256_32(ptr);
+        auto wasm32 = ethash_keccak256_32_wasm(ptr);
+        eosio::check(std::equal(std::begin(host32.bytes), std::end(host32.bytes), std::begin(wasm32.bytes)), "host and wasm keccak differ");
+    }
+#endif
+
+    eosio::check(expected.size() == sizeof(hash.bytes) &&
+                 std::equal(std::begin(hash.bytes), std::end(hash.bytes), reinterpret_cast<const uint8_t*>(expected.data())),
+                 "unexpected keccak256");
+}
+
+[[eosio::action]] std::vector<uint32_t> evm_contract::testalloc(uint32_t rounds) {
+    // Linear memory size after each round of the same allocations, all freed at the end of the round.
+    // Nothing is returned to CDT's malloc, so only the pool allocator keeps the size constant.
+    std::vector<uint32_t> pages;
+    pages.reserve(rounds);
+    for(uint32_t r = 0; r < rounds; ++r) {
+        {
+            std::map<uint64_t, bytes> nodes;
+            for(uint64_t i = 0; i < 256; ++i) {
+                nodes.emplace(i, bytes(16 + (i * 37) % 1024));
+            }
+            std::vector<bytes> buffers;
+            for(size_t i = 0; i < 64; ++i) {
+                buffers.emplace_back(64 + i * 251);
+            }
+        }
+        pages.push_back(uint32_t(__builtin_wasm_memory_size(0)));
+    }
+    return pages;
+}
+
+namespace {
+// Test keys start their chain at the id in their first 8 bytes (big endian)
+uint64_t test_home_id(const checksum256& key, uint64_t) {
+    const auto bytes = key.extract_as_byte_array();
+    uint64_t id = 0;
+    for(size_t i = 0; i < sizeof(id); ++i) id = (id << 8) | bytes[i];
+    return id;
+}
+}
+
+[[eosio::action]] void evm_contract::testslot(uint64_t account_id, const bytes& key, const std::optional<bytes>& value) {
+    eosio::require_auth(get_self());
+    eosio::check(key.size() == 32 && (!value.has_value() || value.value().size() == 32), "invalid key/value size");
+
+    storage_v2_table db(get_self(), account_id);
+    uint64_t free_id;
+    auto itr = find_slot(db, make_key(key), free_id, &test_home_id);
+
+    if(value.has_value()) {
+        if(itr == db.end()) {
+            db.emplace(get_self(), [&](auto& row){
+                row.id = free_id;
+                row.key = make_key(key);
+                row.value = make_key(value.value());
+            });
+        } else {
+            db.modify(*itr, eosio::same_payer, [&](auto& row){
+                row.value = make_key(value.value());
+            });
+        }
+    } else {
+        eosio::check(itr != db.end(), "key not found");
+        erase_slot(db, itr, get_self(), &test_home_id);
+    }
+}
+
 }
@@ -0,0 +1,142 @@
+#include <evm_runtime/transaction.hpp>
+#include <evm_runtime/intrinsics.hpp>
+#include <silkworm/core/common/util.hpp>
+
+namespace evm_runtime {
+
+namespace {
+
+struct rlp_header {
+    size_t offset;  // start of the payload
+    size_t length;  // payload length
+    bool   list;
+};
+
+bool read_header(ByteView rlp, size_t pos, rlp_header& h) {
+    if (pos >= rlp.size()) return false;
+    uint8_t b = rlp[pos];
+    if (b < 0x80) {
+        h = {pos, 1, false};
+    } else if (b < 0xb8) {
+        h = {pos + 1, size_t(b - 0x80), false};
+    } else if (b < 0xc0 || b >= 0xf8) {
+        size_t len_of_len = b < 0xc0 ? b - 0xb7 : b - 0xf7;
+        if (len_of_len > 4 || pos + 1 + len_of_len > rlp.size()) return false;
+        size_t len = 0;
+        for (size_t i = 0; i < len_of_len; ++i) len = (len << 8) | rlp[pos + 1 + i];
+        h = {pos + 1 + len_of_len, len, b >= 0xf8};
+    } else {
+        h = {pos + 1, size_t(b - 0xc0), true};
+    }
+    return h.offset + h.length <= rlp.size();
+}
+
+size_t write_list_header(uint8_t* out, size_t len) {
+    if (len < 56) {
+        out[0] = 0xc0 + len;
+        return 1;
+    }
+    size_t n = 0;
+    for (size_t l = len; l; l >>= 8) ++n;
+    out[0] = 0xf7 + n;
+    for (size_t i = 0; i < n; ++i) out[n - i] = uint8_t(len >> (8 * i));
+    return n + 1;
+}
+
+size_t write_uint(uint8_t* out, const intx::uint256& v) {
+    uint8_t be[32];
+    intx::be::unsafe::store(be, v);
+    size_t skip = 0;
+    while (skip < sizeof(be) && be[skip] == 0) ++skip;
+    size_t n = sizeof(be) - skip;
+    if (n == 1 && be[31] < 0x80) {
+        out[0] = be[31];
+        return 1;
+    }
+    out[0] = 0x80 + n;
+    memcpy(out + 1, be + skip, n);
+    return n + 1;
+}
+
+} // namespace
+
+std::optional<ethash::hash256> signing_hash(char* rlptx, size_t size, const silkworm::Transaction& tx) {
+    ByteView rlp{(const uint8_t*)rlptx, size};
+
+    // Number of leading fields that are signed; typed transactions are prefixed by their type byte
+    size_t pos = 0, fields = 0;
+    switch (tx.type) {
+        case silkworm::TransactionType::kLegacy:     fields = 6; break;
+        case silkworm::TransactionType::kAccessList: fields = 8; pos = 1; break;
+        case silkworm::TransactionType::kDynamicFee: fields = 9; pos = 1; break;
+        default: return {};
+    }
+    if (pos && (rlp.empty() || rlp[0] != uint8_t(tx.type))) return {};
+
+    rlp_header list;
+    if (!read_header(rlp, pos, list) || !list.list) return {};
+    size_t end = list.offset;
+    for (size_t i = 0; i < fields; ++i) {
+        rlp_header item;
+        if (!read_header(rlp, end, item)) return {};
+        end = item.offset + item.length;
+    }
+
+    // EIP-155 replaces v, r and s by chain id, 0 and 0
+    uint8_t suffix[36];
+    size_t suffix_size = 0;
+    if (tx.type == silkworm::TransactionType::kLegacy && tx.chain_id) {
+        suffix_size = write_uint(suffix, *tx.chain_id);
+        suffix[suffix_size++] = 0x80;
+        suffix[suffix_size++] = 0x80;
+    }
+
+    // The new header is never longer than the old one and the suffix always fits where v, r and s were
+    uint8_t prefix[10];
+    size_t prefix_size = 0;
+    if (pos) prefix[prefix_size++] = rlp[0];
+    prefix_size += write_list_header(prefix + prefix_size, end - list.offset + suffix_size);
+    if (prefix_size > list.offset || end + suffix_size > list.offset + list.length) return {};
+
+    uint8_t* buf = (uint8_t*)rlptx;
+    size_t start = list.offset - prefix_size;
+    uint8_t saved_prefix[sizeof(prefix)], saved_suffix[sizeof(suffix)];
+    memcpy(saved_prefix, buf + start, prefix_size);
+    memcpy(saved_suffix, buf + end, suffix_size);
+    memcpy(buf + start, prefix, prefix_size);
+    memcpy(buf + end, suffix, suffix_size);
+
+    ethash::hash256 hash{ethash::keccak256(buf + start, end + suffix_size - start)};
+
+    memcpy(buf + start, saved_prefix, prefix_size);
+    memcpy(buf + end, saved_suffix, suffix_size);
+    return hash;
+}
+
+std::optional<evmc::address> recover_sender_host(const silkworm::Transaction& tx) {
+    Bytes rlp;
+    tx.encode_for_signing(rlp);
+    return recover_sender_host(tx, silkworm::keccak256(rlp));
+}
+
+std::optional<evmc::address> recover_sender_host(const silkworm::Transaction& tx, const ethash::hash256& signing_hash) {
+    // Host format: recovery id + 27 followed by r and s
+    uint8_t signature[65];
+    signature[0] = 27 + (tx.odd_y_parity ? 1 : 0);
+    intx::be::unsafe::store(signature + 1, tx.r);
+    intx::be::unsafe::store(signature + 33, tx.s);
+
+    uint8_t pub[65];
+    if (eosio::internal_use_do_not_use::k1_recover((const char*)signature, sizeof(signature),
+            (const char*)signing_hash.bytes, sizeof(signing_hash.bytes), (char*)pub, sizeof(pub)) != 0) {
+        return {};
+    }
+
+    // Address is the last 20 bytes of the hash of the uncompressed key (without its 0x04 prefix)
+    ethash::hash256 key_hash{ethash::keccak256(pub + 1, sizeof(pub) - 1)};
+    evmc::address res;
+    memcpy(res.bytes, key_hash.bytes + 12, sizeof(res.bytes));
+    return res;
+}
+
+} // namespace evm_runtime
@@ -61,6 +61,34 @@ uint256 to_uint256(const bytes& value) {
     return intx::be::load<uint256>(tmp);
 }
 
+checksum160 to_checksum160(const evmc::address& addr) {
+    return checksum160(addr.bytes);
+}
+
+checksum256 to_checksum256(const uint256& val) {
+    uint8_t tmp[32];
+    intx::be::store(tmp, val);
+    return checksum256(tmp);
+}
+
+evmc::address to_address(const checksum160& addr) {
+    evmc::address res;
+    auto b = addr.extract_as_byte_array();
+    memcpy(res.bytes, b.data(), b.size());
+    return res;
+}
+
+evmc::bytes32 to_bytes32(const checksum256& data) {
+    evmc::bytes32 res;
+    auto b = data.extract_as_byte_array();
+    memcpy(res.bytes, b.data(), b.size());
+    return res;
+}
+
+uint256 to_uint256(const checksum256& value) {
+    return intx::be::load<uint256>(to_bytes32(value));
+}
+
 uint64_t pow10_const(int v) {
     eosio::check(v >= 0, "invalid exponent");
     uint64_t r = 1;
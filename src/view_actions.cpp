@@ -0,0 +1,101 @@
+#include <evm_runtime/evm_contract.hpp>
+#include <evm_runtime/tables.hpp>
+#include <evm_runtime/state.hpp>
+#include <evm_runtime/config_wrapper.hpp>
+
+extern "C" {
+__attribute__((eosio_wasm_import))
+void set_action_return_value(void*, size_t);
+}
+
+namespace evm_runtime {
+
+// Upper bound of getstorage page sizes, keeps a page well inside the CPU of a read-only transaction
+static constexpr uint32_t max_storage_page = 500;
+
+namespace {
+
+template <typename T>
+void return_packed(const T& value) {
+    auto bin = eosio::pack(value);
+    set_action_return_value(bin.data(), bin.size());
+}
+
+} // namespace
+
+[[eosio::action]] void evm_contract::getaccounts(const std::vector<bytes>& addresses) {
+    evm_runtime::state state{get_self(), get_self(), true, true, _config->use_fixed_rows()};
+
+    std::vector<account_summary> res;
+    res.reserve(addresses.size());
+    for (const auto& address : addresses) {
+        auto account = state.read_account(to_address(address));
+        account_summary summary{.address = address, .exists = account.has_value()};
+        if (account) {
+            summary.nonce = account->nonce;
+            summary.balance = to_bytes(account->balance);
+            summary.code_hash = to_bytes(account->code_hash);
+        }
+        res.push_back(std::move(summary));
+    }
+    return_packed(res);
+}
+
+[[eosio::action]] void evm_contract::getcode(const bytes& address) {
+    evm_runtime::state state{get_self(), get_self(), true, true, _config->use_fixed_rows()};
+
+    bytes code;
+    auto account = state.read_account(to_address(address));
+    if (account && account->code_hash != silkworm::kEmptyHash) {
+        auto view = state.read_code(account->code_hash);
+        code.assign(view.begin(), view.end());
+    }
+    return_packed(code);
+}
+
+[[eosio::action]] void evm_contract::getstorage(const bytes& address, const std::optional<storage_cursor>& cursor, uint32_t limit) {
+    eosio::check(limit > 0, "limit must be positive");
+    limit = std::min(limit, max_storage_page);
+
+    evm_runtime::state state{get_self(), get_self(), true, true, _config->use_fixed_rows()};
+
+    storage_page page;
+    account_ref row = state.find_account(to_address(address));
+    if (!row) {
+        return_packed(page);
+        return;
+    }
+
+    // v1 accounts only have legacy rows, v2 accounts only have storage2 rows unless migrated
+    const bool has_legacy = row.v1 || row.v2->has_flag(account::flag::legacy_storage);
+    const bool has_v2 = row.v2 != nullptr;
+    storage_cursor pos = cursor ? *cursor : storage_cursor{.v2 = !has_legacy, .id = 0};
+
+    if (!pos.v2 && has_legacy) {
+        auto& db = state.get_storage_table(row.id());
+        for (auto itr = db.lower_bound(pos.id); itr != db.end(); ++itr) {
+            if (page.entries.size() == limit) {
+                page.next = storage_cursor{.v2 = false, .id = itr->id};
+                return_packed(page);
+                return;
+            }
+            page.entries.push_back({itr->key, to_bytes(itr->get_value())});
+        }
+        pos = storage_cursor{.v2 = true, .id = 0};
+    }
+
+    if (pos.v2 && has_v2) {
+        auto& db = state.get_storage_v2_table(row.id());
+        for (auto itr = db.lower_bound(pos.id); itr != db.end(); ++itr) {
+            if (page.entries.size() == limit) {
+                page.next = storage_cursor{.v2 = true, .id = itr->id};
+                break;
+            }
+            page.entries.push_back({to_bytes(to_bytes32(itr->key)), to_bytes(itr->get_value())});
+        }
+    }
+
+    return_packed(page);
+}
+
+} // namespace evm_runtime
@@ -251,4 +251,51 @@ BOOST_FIXTURE_TEST_CASE(transition_from_0_5_1, account_id_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(fixed_row_migration, account_id_tester) try {
+
+   // evm1 is created in the legacy account table
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(10000), evm1.address_0x());
+   auto before = find_account_by_address(evm1.address).value();
+   BOOST_CHECK(get_max_account_id().value() == before.id);
+   BOOST_CHECK(!before.has_flag(account_object::flag::legacy_storage));
+
+   BOOST_REQUIRE_EXCEPTION(usefixedrows(evm_account_name),
+      eosio_assert_message_exception, eosio_assert_message_is("evm_version must >= 1"));
+
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+   usefixedrows(evm_account_name);
+   BOOST_REQUIRE_EXCEPTION(usefixedrows(evm_account_name),
+      eosio_assert_message_exception, eosio_assert_message_is("fixed rows already enabled"));
+
+   // New accounts go straight to the fixed-width table
+   evm_eoa evm2;
+   transfer_token("alice"_n, evm_account_name, make_asset(10000), evm2.address_0x());
+   auto evm2_account = find_account_by_address(evm2.address).value();
+   BOOST_CHECK(evm2_account.id == before.id + 1);
+   BOOST_CHECK(!evm2_account.has_flag(account_object::flag::legacy_storage));
+   BOOST_CHECK(get_max_account_id().value() == before.id);
+
+   // A second deposit finds evm2 in the fixed-width table instead of creating it again
+   transfer_token("alice"_n, evm_account_name, make_asset(10000), evm2.address_0x());
+   auto evm2_again = find_account_by_address(evm2.address).value();
+   BOOST_CHECK(evm2_again.id == evm2_account.id);
+   BOOST_CHECK(evm2_again.balance == 2 * evm2_account.balance);
+   BOOST_CHECK(get_config2().next_account_id == before.id + 2);
+
+   // Touching evm1 moves its row to the fixed-width table keeping the same id
+   transfer_token("alice"_n, evm_account_name, make_asset(10000), evm1.address_0x());
+   auto after = find_account_by_address(evm1.address).value();
+   BOOST_CHECK(after.id == before.id);
+   BOOST_CHECK(after.balance == 2 * before.balance);
+   BOOST_CHECK(after.has_flag(account_object::flag::legacy_storage));
+   BOOST_CHECK(!get_max_account_id().has_value());
+   BOOST_CHECK(find_account_by_id(before.id).value().address == evm1.address);
+   BOOST_CHECK(get_config2().next_account_id == before.id + 2);
+
+   check_balances();
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
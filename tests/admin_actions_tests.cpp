@@ -137,6 +137,51 @@ BOOST_FIXTURE_TEST_CASE(rmgcstore_tests, admin_action_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(gc_on_pushtx_tests, admin_action_tester) try {
+
+   evm_eoa evm1;
+   const int64_t to_bridge = 1000000;
+   transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+
+   auto [contract_addr, contract_account_id] = deploy_simple_contract(evm1);
+
+   // Call method "setval" on simple contract (sha3('setval(uint256)') = 0x559c9c4a)
+   auto txn = generate_tx(contract_addr, 0, 500'000);
+   txn.data = evmc::from_hex("0x559c9c4a").value();
+   txn.data += evmc::from_hex("0x0000000000000000000000000000000000000000000000000000000000000042").value();
+   evm1.sign(txn);
+   pushtx(txn);
+
+   auto total_slots = [&]() {
+      size_t total = 0;
+      scan_account_storage(contract_account_id, [&](storage_slot&&) -> bool {
+         ++total;
+         return false;
+      });
+      return total;
+   };
+   BOOST_REQUIRE(total_slots() == 2);
+
+   // Call method "killme" on simple contract (sha3('killme()') = 0x24d97a4a)
+   txn = generate_tx(contract_addr, 0, 500'000);
+   txn.data = evmc::from_hex("0x24d97a4a").value();
+   evm1.sign(txn);
+   pushtx(txn);
+
+   // Storage of an account removed by a transaction is left for later ones
+   BOOST_REQUIRE(total_gcrows() == 1);
+   BOOST_REQUIRE(total_slots() == 2);
+
+   evm_eoa evm2;
+   txn = generate_tx(evm2.address, 1);
+   evm1.sign(txn);
+   pushtx(txn);
+
+   BOOST_REQUIRE(total_gcrows() == 0);
+   BOOST_REQUIRE(total_slots() == 0);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(setkvstore_tests, admin_action_tester) try {
 
    // Fund evm1 address with 100 EOS
@@ -201,6 +246,209 @@ BOOST_FIXTURE_TEST_CASE(setkvstore_tests, admin_action_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(setkvstore_collision_chain, admin_action_tester) try {
+
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+   usefixedrows(evm_account_name);
+
+   // Slots only go to storage2 for accounts in the fixed-width table
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+   const uint64_t account_id = find_account_by_address(evm1.address).value().id;
+
+   // Keys crafted to collide under a plain fold of their 64-bit words, plus a run of
+   // consecutive solidity array slots. All of them must start their own chain.
+   const auto base = intx::uint256(0x1234);
+   std::vector<intx::uint256> keys;
+   for(uint64_t i = 1; i <= 8; ++i) {
+      keys.push_back(base ^ (intx::uint256(i) << 64));
+      keys.push_back(base ^ (intx::uint256(i) << 128));
+      keys.push_back(base ^ (intx::uint256(i) << 192));
+      keys.push_back(base ^ (intx::uint256(i) << 64) ^ (intx::uint256(i) << 128));
+      keys.push_back(base + i);
+   }
+
+   // First 8 bytes (little endian) of sha256(key || account_id)
+   auto home_id = [&](const intx::uint256& key) {
+      uint8_t buffer[40];
+      intx::be::store(buffer, key);
+      memcpy(buffer + 32, &account_id, sizeof(account_id));
+      auto digest = fc::sha256::hash((const char*)buffer, sizeof(buffer));
+      uint64_t id;
+      memcpy(&id, digest.data(), sizeof(id));
+      return id;
+   };
+
+   std::map<intx::uint256, uint64_t> ids;
+   auto load_ids = [&]() {
+      ids.clear();
+      scan_account_storage(account_id, [&](storage_slot&& slot) -> bool {
+         ids[slot.key] = slot.id;
+         return false;
+      });
+   };
+
+   for(size_t i = 0; i < keys.size(); ++i) {
+      setkvstore(account_id, to_bytes(keys[i]), to_bytes(intx::uint256(i + 1)));
+   }
+
+   load_ids();
+   BOOST_REQUIRE(ids.size() == keys.size());
+   for(const auto& key : keys) {
+      BOOST_REQUIRE(ids[key] == home_id(key));
+   }
+
+   // Every slot is still reachable and erasable
+   for(const auto& key : keys) {
+      setkvstore(account_id, to_bytes(key), {});
+   }
+   load_ids();
+   BOOST_REQUIRE(ids.empty());
+
+   BOOST_REQUIRE_EXCEPTION(setkvstore(account_id, to_bytes(keys[0]), {}),
+      eosio_assert_message_exception, eosio_assert_message_is("key not found"));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(storage_slot_probe_chain, admin_action_tester) try {
+
+   // testslot stores keys in storage2 with the home id in their first 8 bytes
+   const uint64_t account_id = 999;
+   auto key = [](uint64_t home, uint64_t n) { return (intx::uint256(home) << 192) | n; };
+   auto testslot = [&](const intx::uint256& k, const std::optional<intx::uint256>& v) {
+      std::optional<bytes> value;
+      if (v) value = to_bytes(*v);
+      return push_action(evm_account_name, "testslot"_n, evm_account_name,
+         mvo()("account_id", account_id)("key", to_bytes(k))("value", value));
+   };
+
+   std::map<intx::uint256, std::pair<uint64_t, intx::uint256>> rows;
+   auto load_rows = [&]() {
+      rows.clear();
+      scan_account_storage(account_id, [&](storage_slot&& slot) -> bool {
+         rows[slot.key] = {slot.id, slot.value};
+         return false;
+      });
+   };
+   auto require_ids = [&](const std::map<intx::uint256, uint64_t>& expected) {
+      load_rows();
+      BOOST_REQUIRE(rows.size() == expected.size());
+      for (const auto& [k, id] : expected) {
+         BOOST_REQUIRE(rows.count(k) == 1);
+         BOOST_REQUIRE(rows[k].first == id);
+      }
+   };
+
+   // Colliding keys take the next free ids, a key whose home is taken goes after them
+   const auto a = key(100, 1), b = key(100, 2), c = key(100, 3), d = key(101, 4);
+   for (const auto& k : {a, b, c, d}) testslot(k, k);
+   require_ids({{a, 100}, {b, 101}, {c, 102}, {d, 103}});
+
+   // Erasing in the middle shifts the rest of the chain back, every key stays findable
+   testslot(b, {});
+   require_ids({{a, 100}, {c, 101}, {d, 102}});
+   testslot(c, intx::uint256(33));
+   testslot(d, intx::uint256(44));
+   require_ids({{a, 100}, {c, 101}, {d, 102}});
+   BOOST_REQUIRE(rows[c].second == 33);
+   BOOST_REQUIRE(rows[d].second == 44);
+   BOOST_REQUIRE_EXCEPTION(testslot(b, {}),
+      eosio_assert_message_exception, eosio_assert_message_is("key not found"));
+
+   // A row already at its home id is not moved into the gap before it
+   testslot(d, {});
+   const auto e = key(102, 5), f = key(100, 6);
+   testslot(e, e);
+   testslot(f, f);
+   require_ids({{a, 100}, {c, 101}, {e, 102}, {f, 103}});
+   testslot(a, {});
+   require_ids({{c, 100}, {f, 101}, {e, 102}});
+
+   // Chains wrap around the end of the id space
+   const auto g = key(UINT64_MAX, 7), h = key(UINT64_MAX, 8);
+   testslot(g, g);
+   testslot(h, h);
+   require_ids({{c, 100}, {f, 101}, {e, 102}, {g, UINT64_MAX}, {h, 0}});
+   testslot(g, {});
+   require_ids({{c, 100}, {f, 101}, {e, 102}, {h, UINT64_MAX}});
+
+   // A chain holds at most max_slot_probe (16) keys
+   for (uint64_t n = 0; n < 16; ++n) testslot(key(1000, n), intx::uint256(n));
+   load_rows();
+   BOOST_REQUIRE(rows[key(1000, 15)].first == 1015);
+   BOOST_REQUIRE_EXCEPTION(testslot(key(1000, 16), intx::uint256(16)),
+      eosio_assert_message_exception, eosio_assert_message_is("storage slot probe limit exceeded"));
+   BOOST_REQUIRE_EXCEPTION(testslot(key(1000, 16), {}),
+      eosio_assert_message_exception, eosio_assert_message_is("storage slot probe limit exceeded"));
+
+   // Keys already in the full chain are still found and erased
+   testslot(key(1000, 0), {});
+   load_rows();
+   BOOST_REQUIRE(rows[key(1000, 15)].first == 1014);
+   testslot(key(1000, 16), intx::uint256(16));
+   load_rows();
+   BOOST_REQUIRE(rows[key(1000, 16)].first == 1015);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(setkvstore_legacy_account_fixed_rows, admin_action_tester) try {
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+
+   // Deployed before fixed rows are enabled, so the contract stays in the legacy account table
+   evmc::address contract_addr;
+   uint64_t contract_account_id;
+   std::tie(contract_addr, contract_account_id) = deploy_simple_contract(evm1);
+
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+   usefixedrows(evm_account_name);
+   produce_blocks(2);
+
+   std::map<intx::uint256, uint64_t> ids;
+   auto load_ids = [&]() {
+      ids.clear();
+      scan_account_storage(contract_account_id, [&](storage_slot&& slot) -> bool {
+         ids[slot.key] = slot.id;
+         return false;
+      });
+   };
+
+   // A new slot of a non-migrated account must go where the EVM looks for it
+   setkvstore(contract_account_id, to_bytes(intx::uint256(0)), to_bytes(intx::uint256(77)));
+   produce_blocks(2);
+   BOOST_REQUIRE(getval(contract_addr) == intx::uint256(77));
+
+   // Legacy rows take the next primary key of the account's storage table
+   load_ids();
+   BOOST_REQUIRE(ids.size() == 2);
+   BOOST_REQUIRE(ids[intx::uint256(0)] == 1);
+
+   // A write from the EVM migrates the account and moves the slot to storage2
+   auto txn = generate_tx(contract_addr, 0, 500'000);
+   txn.data = evmc::from_hex("0x559c9c4a").value();
+   txn.data += evmc::from_hex("0x0000000000000000000000000000000000000000000000000000000000000042").value();
+   evm1.sign(txn);
+   pushtx(txn);
+   BOOST_REQUIRE(getval(contract_addr) == intx::uint256(66));
+
+   load_ids();
+   BOOST_REQUIRE(ids.size() == 2);
+   BOOST_REQUIRE(ids[intx::uint256(0)] != 1);
+
+   // From now on the account is in the fixed-width table and so are its new slots
+   setkvstore(contract_account_id, to_bytes(intx::uint256(0)), to_bytes(intx::uint256(88)));
+   produce_blocks(2);
+   BOOST_REQUIRE(getval(contract_addr) == intx::uint256(88));
+
+   setkvstore(contract_account_id, to_bytes(intx::uint256(0)), {});
+   produce_blocks(2);
+   BOOST_REQUIRE(getval(contract_addr) == intx::uint256(0));
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(rmaccount_tests, admin_action_tester) try {
 
    // Fund evm1 address with 100 EOS
@@ -56,6 +56,23 @@ struct storage_table_row
    bytes value;
 };
 
+struct account_v2_table_row
+{
+   uint64_t id;
+   fc::ripemd160 eth_address;
+   uint64_t nonce;
+   fc::sha256 balance;
+   std::optional<uint64_t> code_id;
+   uint32_t flags;
+};
+
+struct storage_v2_table_row
+{
+   uint64_t id;
+   fc::sha256 key;
+   fc::sha256 value;
+};
+
 } // namespace evm_test
 
 namespace fc { namespace raw {
@@ -116,6 +133,8 @@ namespace fc { namespace raw {
 FC_REFLECT(evm_test::vault_balance_row, (owner)(balance)(dust))
 FC_REFLECT(evm_test::partial_account_table_row, (id)(eth_address)(nonce)(balance)(code_id)(flags))
 FC_REFLECT(evm_test::storage_table_row, (id)(key)(value))
+FC_REFLECT(evm_test::account_v2_table_row, (id)(eth_address)(nonce)(balance)(code_id)(flags))
+FC_REFLECT(evm_test::storage_v2_table_row, (id)(key)(value))
 
 namespace evm_test {
 
@@ -388,6 +407,16 @@ transaction_trace_ptr basic_evm_tester::exec(const exec_input& input, const std:
    return basic_evm_tester::push_action(evm_account_name, "exec"_n, evm_account_name, bytes{binary_data.begin(), binary_data.end()});
 }
 
+transaction_trace_ptr basic_evm_tester::execbatch(const std::vector<exec_input>& inputs) {
+   auto binary_data = fc::raw::pack(inputs);
+   return basic_evm_tester::push_action(evm_account_name, "execbatch"_n, evm_account_name, bytes{binary_data.begin(), binary_data.end()});
+}
+
+transaction_trace_ptr basic_evm_tester::estimategas(const exec_input& input) {
+   auto binary_data = fc::raw::pack(input);
+   return basic_evm_tester::push_action(evm_account_name, "estimategas"_n, evm_account_name, bytes{binary_data.begin(), binary_data.end()});
+}
+
 transaction_trace_ptr basic_evm_tester::call(name from, const evmc::bytes& to, const evmc::bytes& value, evmc::bytes& data, uint64_t gas_limit, name actor)
 {
    bytes to_bytes;
@@ -460,11 +489,27 @@ transaction_trace_ptr basic_evm_tester::pushtx(const silkworm::Transaction& trx,
    }
 }
 
+transaction_trace_ptr basic_evm_tester::pushtxs(const std::vector<silkworm::Transaction>& trxs, name miner)
+{
+   std::vector<bytes> rlptxs;
+   for (const auto& trx : trxs) {
+      silkworm::Bytes rlp;
+      silkworm::rlp::encode(rlp, trx, false);
+      rlptxs.emplace_back(rlp.begin(), rlp.end());
+   }
+
+   return push_action(evm_account_name, "pushtxs"_n, miner, mvo()("miner", miner)("rlptxs", rlptxs));
+}
+
 transaction_trace_ptr basic_evm_tester::setversion(uint64_t version, name actor) {
    return basic_evm_tester::push_action(evm_account_name, "setversion"_n, actor,
       mvo()("version", version));
 }
 
+transaction_trace_ptr basic_evm_tester::usefixedrows(name actor) {
+   return basic_evm_tester::push_action(evm_account_name, "usefixedrows"_n, actor, mvo());
+}
+
 transaction_trace_ptr basic_evm_tester::updtgasparam(asset ram_price_mb, uint64_t gas_price, name actor) {
    return basic_evm_tester::push_action(evm_account_name, "updtgasparam"_n, actor,
       mvo()("ram_price_mb", ram_price_mb)("gas_price", gas_price));
@@ -561,6 +606,16 @@ void basic_evm_tester::withdraw(name owner, asset quantity)
    push_action(evm_account_name, "withdraw"_n, owner, mvo()("owner", owner)("quantity", quantity));
 }
 
+transaction_trace_ptr basic_evm_tester::withdrawmany(name actor, const std::vector<withdraw_request>& withdrawals)
+{
+   return push_action(evm_account_name, "withdrawmany"_n, actor, mvo()("withdrawals", withdrawals));
+}
+
+transaction_trace_ptr basic_evm_tester::depositmany(name from, const std::vector<deposit_request>& deposits)
+{
+   return push_action(evm_account_name, "depositmany"_n, from, mvo()("from", from)("deposits", deposits));
+}
+
 balance_and_dust basic_evm_tester::inevm() const {
    return fc::raw::unpack<balance_and_dust>(get_row_by_account(evm_account_name, evm_account_name, "inevm"_n, "inevm"_n));
 }
@@ -617,11 +672,38 @@ std::optional<account_object> convert_to_account_object(const partial_account_ta
    };
 }
 
+account_object convert_to_account_object(const account_v2_table_row& row)
+{
+   evmc::address address(0);
+   std::memcpy(address.bytes, row.eth_address.data(), sizeof(address.bytes));
+
+   return account_object{
+      .id = row.id,
+      .address = std::move(address),
+      .nonce = row.nonce,
+      .balance = intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(row.balance.data())),
+      .code_id = row.code_id,
+      .flags = row.flags
+   };
+}
+
 bool basic_evm_tester::scan_accounts(std::function<bool(account_object)> visitor) const
 {
    static constexpr eosio::chain::name account_table_name = "account"_n;
+   static constexpr eosio::chain::name account_v2_table_name = "account2"_n;
 
    bool successful = true;
+   bool done = false;
+
+   scan_table<account_v2_table_row>(
+      account_v2_table_name, evm_account_name, [&visitor, &done](account_v2_table_row&& row) {
+         done = visitor(convert_to_account_object(row));
+         return done;
+      });
+
+   if (done) {
+      return successful;
+   }
 
    scan_table<partial_account_table_row>(
       account_table_name, evm_account_name, [this, &visitor, &successful](partial_account_table_row&& row) {
@@ -655,49 +737,63 @@ std::optional<account_object> basic_evm_tester::scan_for_account_by_address(cons
 std::optional<account_object> basic_evm_tester::find_account_by_address(const evmc::address& address) const
 {
    static constexpr eosio::chain::name account_table_name = "account"_n;
-
-   std::optional<account_object> result;
+   static constexpr eosio::chain::name account_v2_table_name = "account2"_n;
 
    const auto& db = control->db();
 
-   const auto* t_id = db.find<chain::table_id_object, chain::by_code_scope_table>(
-      boost::make_tuple(evm_account_name, evm_account_name, account_table_name));
-
-   if (!t_id) {
-      return std::nullopt;
-   }
-
    uint8_t address_buffer[32] = {0};
    std::memcpy(address_buffer, address.bytes, sizeof(address.bytes));
 
-   const auto* secondary_row = db.find<chain::index256_object, chain::by_secondary>(
-      boost::make_tuple(t_id->id, fixed_bytes<32>(address_buffer).get_array()));
+   auto find_row = [&](eosio::chain::name table_name) -> const chain::key_value_object* {
+      const auto* t_id = db.find<chain::table_id_object, chain::by_code_scope_table>(
+         boost::make_tuple(evm_account_name, evm_account_name, table_name));
 
-   if (!secondary_row) {
-      return std::nullopt;
-   }
+      if (!t_id) {
+         return nullptr;
+      }
 
-   const auto* primary_row = db.find<chain::key_value_object, chain::by_scope_primary>(
-      boost::make_tuple(t_id->id, secondary_row->primary_key));
+      const auto* secondary_row = db.find<chain::index256_object, chain::by_secondary>(
+         boost::make_tuple(t_id->id, fixed_bytes<32>(address_buffer).get_array()));
 
-   if (!primary_row) {
-      return std::nullopt;
+      if (!secondary_row) {
+         return nullptr;
+      }
+
+      return db.find<chain::key_value_object, chain::by_scope_primary>(
+         boost::make_tuple(t_id->id, secondary_row->primary_key));
+   };
+
+   if (const auto* primary_row = find_row(account_v2_table_name)) {
+      account_v2_table_row row;
+      fc::datastream<const char*> ds(primary_row->value.data(), primary_row->value.size());
+      fc::raw::unpack(ds, row);
+      return convert_to_account_object(row);
    }
 
-   {
+   if (const auto* primary_row = find_row(account_table_name)) {
       partial_account_table_row row;
       fc::datastream<const char*> ds(primary_row->value.data(), primary_row->value.size());
       fc::raw::unpack(ds, row);
-
-      result = convert_to_account_object(row);
+      return convert_to_account_object(row);
    }
 
-   return result;
+   return std::nullopt;
 }
 
 std::optional<account_object> basic_evm_tester::find_account_by_id(uint64_t id) const
 {
    static constexpr eosio::chain::name account_table_name = "account"_n;
+   static constexpr eosio::chain::name account_v2_table_name = "account2"_n;
+
+   const vector<char> d2 =
+      get_row_by_account(evm_account_name, evm_account_name, account_v2_table_name, name{id});
+   if(!d2.empty()) {
+      account_v2_table_row row;
+      fc::datastream<const char*> ds(d2.data(), d2.size());
+      fc::raw::unpack(ds, row);
+      return convert_to_account_object(row);
+   }
+
    const vector<char> d =
       get_row_by_account(evm_account_name, evm_account_name, account_table_name, name{id});
    if(d.empty()) return {};
@@ -730,8 +826,23 @@ intx::uint128 basic_evm_tester::tx_data_cost(const silkworm::Transaction& txn) c
 bool basic_evm_tester::scan_account_storage(uint64_t account_id, std::function<bool(storage_slot)> visitor) const
 {
    static constexpr eosio::chain::name storage_table_name = "storage"_n;
+   static constexpr eosio::chain::name storage_v2_table_name = "storage2"_n;
 
    bool successful = true;
+   bool done = false;
+
+   scan_table<storage_v2_table_row>(
+      storage_v2_table_name, name{account_id}, [&visitor, &done](storage_v2_table_row&& row) {
+         done = visitor(storage_slot{
+            .id = row.id,
+            .key = intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(row.key.data())),
+            .value = intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(row.value.data()))});
+         return done;
+      });
+
+   if (done) {
+      return successful;
+   }
 
    scan_table<storage_table_row>(
       storage_table_name, name{account_id}, [&visitor, &successful](storage_table_row&& row) {
@@ -140,7 +140,8 @@ struct balance_and_dust
 struct account_object
 {
    enum class flag : uint32_t {
-      frozen = 0x1
+      frozen = 0x1,
+      legacy_storage = 0x2
    };
 
    uint64_t id;
@@ -189,6 +190,25 @@ struct exec_output {
    std::optional<bytes> context;
 };
 
+struct estimate_output {
+   int32_t  status;
+   uint64_t gas;
+   uint64_t gas_used;
+   uint64_t gas_refund;
+   bytes    data;
+};
+
+struct withdraw_request {
+   name                owner;
+   asset               quantity;
+   std::optional<name> to;
+};
+
+struct deposit_request {
+   bytes address;
+   asset quantity;
+};
+
 struct message_receiver {
     name     account;
     name     handler;
@@ -204,6 +224,27 @@ struct bridge_message_v0 {
    bytes      data;
 };
 
+struct table_stats {
+   uint32_t read=0;
+   uint32_t update=0;
+   uint32_t create=0;
+   uint32_t remove=0;
+};
+
+struct db_stats {
+   table_stats account;
+   table_stats storage;
+   table_stats code;
+   uint64_t    code_bytes=0;
+   int64_t     ram_delta=0;
+};
+
+struct tx_stats {
+   db_stats db;
+   uint64_t gas_used=0;
+   uint32_t memory_pages=0;
+};
+
 struct gcstore {
     uint64_t id;
     uint64_t storage_id;
@@ -244,9 +285,15 @@ FC_REFLECT(evm_test::fee_parameters, (gas_price)(miner_cut)(ingress_bridge_fee))
 FC_REFLECT(evm_test::exec_input, (context)(from)(to)(data)(value))
 FC_REFLECT(evm_test::exec_callback, (contract)(action))
 FC_REFLECT(evm_test::exec_output, (status)(data)(context))
+FC_REFLECT(evm_test::estimate_output, (status)(gas)(gas_used)(gas_refund)(data))
+FC_REFLECT(evm_test::withdraw_request, (owner)(quantity)(to))
+FC_REFLECT(evm_test::deposit_request, (address)(quantity))
 
 FC_REFLECT(evm_test::message_receiver, (account)(handler)(min_fee)(flags));
 FC_REFLECT(evm_test::bridge_message_v0, (receiver)(sender)(timestamp)(value)(data));
+FC_REFLECT(evm_test::table_stats, (read)(update)(create)(remove));
+FC_REFLECT(evm_test::db_stats, (account)(storage)(code)(code_bytes)(ram_delta));
+FC_REFLECT(evm_test::tx_stats, (db)(gas_used)(memory_pages));
 FC_REFLECT(evm_test::gcstore, (id)(storage_id));
 FC_REFLECT(evm_test::account_code, (id)(ref_count)(code)(code_hash));
 FC_REFLECT(evm_test::evmtx_base, (eos_evm_version)(rlptx));
@@ -467,9 +514,13 @@ public:
    transaction_trace_ptr bridgereg(name receiver, name handler, asset min_fee, vector<account_name> extra_signers={evm_account_name});
    transaction_trace_ptr bridgeunreg(name receiver);
    transaction_trace_ptr exec(const exec_input& input, const std::optional<exec_callback>& callback);
+   transaction_trace_ptr execbatch(const std::vector<exec_input>& inputs);
+   transaction_trace_ptr estimategas(const exec_input& input);
    transaction_trace_ptr assertnonce(name account, uint64_t next_nonce);
    transaction_trace_ptr pushtx(const silkworm::Transaction& trx, name miner = evm_account_name, std::optional<uint64_t> min_inclusion_price={});
+   transaction_trace_ptr pushtxs(const std::vector<silkworm::Transaction>& trxs, name miner = evm_account_name);
    transaction_trace_ptr setversion(uint64_t version, name actor);
+   transaction_trace_ptr usefixedrows(name actor);
    transaction_trace_ptr call(name from, const evmc::bytes& to, const evmc::bytes& value, evmc::bytes& data, uint64_t gas_limit, name actor);
    transaction_trace_ptr admincall(const evmc::bytes& from, const evmc::bytes& to, const evmc::bytes& value, evmc::bytes& data, uint64_t gas_limit, name actor);
    evmc::address deploy_contract(evm_eoa& eoa, evmc::bytes bytecode);
@@ -495,6 +546,8 @@ public:
    void open(name owner);
    void close(name owner);
    void withdraw(name owner, asset quantity);
+   transaction_trace_ptr withdrawmany(name actor, const std::vector<withdraw_request>& withdrawals);
+   transaction_trace_ptr depositmany(name from, const std::vector<deposit_request>& deposits);
 
    balance_and_dust inevm() const;
    void gc(uint32_t max);
@@ -224,6 +224,106 @@ BOOST_FIXTURE_TEST_CASE(exec_with_context, exec_evm_tester) try {
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE(execbatch_isolated_calls, exec_evm_tester) try {
+
+  evm_eoa evm1;
+  transfer_token("alice"_n, "evm"_n, make_asset(1000000), evm1.address_0x());
+  auto token_addr = deploy_evm_token_contract(evm1);
+
+  evm_eoa evm2;
+  erc20_transfer(token_addr, evm1, evm2, 1234);
+
+  auto balance_of = [&](const evm_eoa& account) {
+    silkworm::Bytes data;
+    data += evmc::from_hex("70a08231").value();   // sha3(balanceOf(address))[:4]
+    data += silkworm::to_bytes32(account.address);
+
+    exec_input input;
+    input.to   = bytes{std::begin(token_addr.bytes), std::end(token_addr.bytes)};
+    input.data = bytes{data.begin(), data.end()};
+    return input;
+  };
+
+  // A transfer from evm1 in the middle of the batch is not visible to the calls after it
+  silkworm::Bytes data;
+  data += evmc::from_hex("a9059cbb").value();   // sha3(transfer(address,uint256))[:4]
+  data += silkworm::to_bytes32(evm2.address);
+  data += evmc::bytes32{1111};
+
+  exec_input transfer;
+  transfer.from = bytes{std::begin(evm1.address.bytes), std::end(evm1.address.bytes)};
+  transfer.to   = bytes{std::begin(token_addr.bytes), std::end(token_addr.bytes)};
+  transfer.data = bytes{data.begin(), data.end()};
+
+  const char context[] = "ABCD";
+  auto with_context = balance_of(evm2);
+  with_context.context = bytes{std::begin(context), std::end(context)};
+
+  auto res = execbatch({balance_of(evm2), transfer, with_context});
+  auto outs = fc::raw::unpack<std::vector<exec_output>>(res->action_traces[0].return_value);
+  BOOST_REQUIRE(outs.size() == 3);
+
+  for (const auto& out : outs) BOOST_REQUIRE(out.status == 0);
+  auto balance = [](const exec_output& out) {
+    BOOST_REQUIRE(out.data.size() == 32);
+    return intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(out.data.data()));
+  };
+  BOOST_REQUIRE(balance(outs[0]) == 1234);
+  BOOST_REQUIRE(balance(outs[2]) == 1234);
+  BOOST_REQUIRE(!outs[0].context.has_value());
+  BOOST_REQUIRE(outs[2].context.has_value() && outs[2].context->size() == sizeof(context));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(estimategas_erc20_transfer, exec_evm_tester) try {
+
+  evm_eoa evm1;
+  transfer_token("alice"_n, "evm"_n, make_asset(1000000), evm1.address_0x());
+  auto token_addr = deploy_evm_token_contract(evm1);
+
+  evm_eoa evm2;
+  auto transfer_input = [&](const evm_eoa& from, uint64_t amount) {
+    silkworm::Bytes data;
+    data += evmc::from_hex("a9059cbb").value();   // sha3(transfer(address,uint256))[:4]
+    data += silkworm::to_bytes32(evm2.address);
+    data += evmc::bytes32{amount};
+
+    exec_input input;
+    input.from = bytes{std::begin(from.address.bytes), std::end(from.address.bytes)};
+    input.to   = bytes{std::begin(token_addr.bytes), std::end(token_addr.bytes)};
+    input.data = bytes{data.begin(), data.end()};
+    return input;
+  };
+
+  auto res = estimategas(transfer_input(evm1, 1111));
+  auto out = fc::raw::unpack<estimate_output>(res->action_traces[0].return_value);
+  BOOST_REQUIRE(out.status == 0);
+  BOOST_REQUIRE(out.gas_used > 0);
+  BOOST_REQUIRE(out.gas >= out.gas_used);
+  BOOST_REQUIRE(out.gas_refund == 0);
+
+  // The estimate is enough for the real transaction: intrinsic gas (21000 + 16 per non-zero
+  // calldata byte, 4 per zero byte) on top of the execution gas
+  auto txn = generate_tx(token_addr, 0, 21000 + 68 * 16 + out.gas);
+  txn.data = evmc::from_hex("a9059cbb").value();
+  txn.data += silkworm::to_bytes32(evm2.address);
+  txn.data += evmc::bytes32{1111};
+  evm1.sign(txn);
+  pushtx(txn);
+
+  auto balance_res = erc20_balance(token_addr, evm2);
+  auto balance_out = fc::raw::unpack<exec_output>(balance_res->action_traces[0].return_value);
+  BOOST_REQUIRE(intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(balance_out.data.data())) == 1111);
+
+  // A reverting call reports its status and the gas it used
+  evm_eoa evm3;
+  res = estimategas(transfer_input(evm3, 1));
+  out = fc::raw::unpack<estimate_output>(res->action_traces[0].return_value);
+  BOOST_REQUIRE(out.status == EVMC_REVERT);
+  BOOST_REQUIRE(out.gas == out.gas_used);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(wrong_input_params, exec_evm_tester) try {
 
   exec_input input;
@@ -227,6 +227,43 @@ BOOST_FIXTURE_TEST_CASE(gas_param_traces, gas_param_evm_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(fixed_rows_gas_sset, gas_param_evm_tester) try {
+
+    init();
+    setversion(1, evm_account_name);
+    produce_blocks(2);
+
+    // Latest gas parameters, pending or in effect
+    auto latest_params = [&]() {
+        auto cp = get_config().consensus_parameter.value();
+        const auto& data = cp.pending ? cp.pending->data : cp.current;
+        return std::visit([](const auto& v){ return v.gas_parameter; }, data);
+    };
+
+    // RAM billed for a full storage slot and for a storage2 slot
+    constexpr uint64_t storage_slot_bytes = 346;
+    constexpr uint64_t storage_slot_v2_bytes = 192;
+
+    // gas_codedeposit is the gas per byte of RAM
+    updtgasparam(asset(10'0000, native_symbol), 1'000'000'000, evm_account_name);
+    auto params = latest_params();
+    BOOST_REQUIRE_EQUAL(params.gas_sset, 2900 + storage_slot_bytes * params.gas_codedeposit);
+    produce_blocks(2);
+
+    // Switching to fixed rows rescales gas_sset to the storage2 row size
+    usefixedrows(evm_account_name);
+    params = latest_params();
+    BOOST_REQUIRE_EQUAL(params.gas_sset, 2900 + storage_slot_v2_bytes * params.gas_codedeposit);
+    produce_blocks(2);
+
+    // Later RAM price updates keep using it
+    updtgasparam(asset(20'0000, native_symbol), 1'000'000'000, evm_account_name);
+    auto params2 = latest_params();
+    BOOST_REQUIRE(params2.gas_codedeposit > params.gas_codedeposit);
+    BOOST_REQUIRE_EQUAL(params2.gas_sset, 2900 + storage_slot_v2_bytes * params2.gas_codedeposit);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(gas_param_G_txnewaccount, gas_param_evm_tester) try {
 
     uint64_t suggested_gas_price = 150'000'000'000ull;
@@ -542,4 +579,40 @@ BOOST_FIXTURE_TEST_CASE(gas_limit_internal_transaction, gas_param_evm_tester) tr
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(gas_limit_internal_transaction_existing_account, gas_param_evm_tester) try {
+
+    uint64_t suggested_gas_price = 150'000'000'000ull;
+    init(15555, suggested_gas_price);
+
+    produce_block();
+    fund_evm_faucet();
+    produce_block();
+
+    setversion(1, evm_account_name);
+    produce_block();
+    produce_block();
+
+    setgasparam(1, gas_newaccount, gas_txcreate, gas_codedeposit, gas_sset, evm_account_name);
+    produce_block();
+    produce_block();
+    produce_block();
+
+    // First deposit opens the account (21001 GAS)
+    evm_eoa evm1;
+    auto trace = transfer_token("alice"_n, "evm"_n, make_asset(1), evm1.address_0x());
+    auto tx = get_tx_from_trace(trace->action_traces[4].act.data);
+    BOOST_REQUIRE(tx.gas_limit == 21001);
+    BOOST_REQUIRE(evm_balance(evm1) == 100000000000000);
+
+    // Second one only credits it (21000 GAS)
+    trace = transfer_token("alice"_n, "evm"_n, make_asset(1), evm1.address_0x());
+    tx = get_tx_from_trace(trace->action_traces[3].act.data);
+    BOOST_REQUIRE(tx.gas_limit == 21000);
+    BOOST_REQUIRE(evm_balance(evm1) == 200000000000000);
+    BOOST_REQUIRE(find_account_by_address(evm1.address)->nonce == 0);
+
+    check_balances();
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -781,4 +781,98 @@ BOOST_FIXTURE_TEST_CASE(evm_eos_fanout_out_of_gas, native_token_evm_tester_EOS)
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(withdrawmany_merges_transfers, native_token_evm_tester_EOS) try {
+   open("alice"_n);
+   transfer_token("alice"_n, "evm"_n, make_asset(3'0000), "alice");
+
+   const int64_t alice_native_before = native_balance("alice"_n);
+   const int64_t bob_native_before = native_balance("bob"_n);
+
+   auto trace = withdrawmany("alice"_n, {
+      {"alice"_n, make_asset(5000), "bob"_n},
+      {"alice"_n, make_asset(5000), "bob"_n},
+      {"alice"_n, make_asset(1'0000), {}}
+   });
+
+   //one inline transfer per recipient
+   size_t transfers = 0;
+   for(const auto& at : trace->action_traces) {
+      if(at.receiver == token_account_name && at.act.name == "transfer"_n)
+         ++transfers;
+   }
+   BOOST_REQUIRE_EQUAL(transfers, 2u);
+
+   BOOST_REQUIRE_EQUAL(native_balance("bob"_n) - bob_native_before, 1'0000);
+   BOOST_REQUIRE_EQUAL(native_balance("alice"_n) - alice_native_before, 1'0000);
+   BOOST_REQUIRE_EQUAL(vault_balance_token("alice"_n), 1'0000);
+
+   //each entry fits but together they overdraw
+   BOOST_REQUIRE_EXCEPTION(withdrawmany("alice"_n, {{"alice"_n, make_asset(6000), {}}, {"alice"_n, make_asset(6000), {}}}),
+                           eosio_assert_message_exception, eosio_assert_message_is("overdrawn balance"));
+
+   BOOST_REQUIRE_EXCEPTION(withdrawmany("alice"_n, {{"alice"_n, make_asset(0), {}}}),
+                           eosio_assert_message_exception, eosio_assert_message_is("must withdraw positive quantity"));
+
+   BOOST_REQUIRE_EXCEPTION(withdrawmany("bob"_n, {{"alice"_n, make_asset(1000), "bob"_n}}),
+                           missing_auth_exception, eosio::testing::fc_exception_message_starts_with("missing authority"));
+
+   BOOST_REQUIRE_EXCEPTION(withdrawmany("alice"_n, {}),
+                           eosio_assert_message_exception, eosio_assert_message_is("no withdrawals"));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(depositmany_from_open_balance, native_token_evm_tester_EOS) try {
+   evm_eoa evm1, evm2;
+   const intx::uint256 smallest = 100_szabo;
+
+   auto address_of = [](const evm_eoa& eoa) {
+      return bytes{std::begin(eoa.address.bytes), std::end(eoa.address.bytes)};
+   };
+
+   open("alice"_n);
+   transfer_token("alice"_n, "evm"_n, make_asset(5'0000), "alice");
+
+   depositmany("alice"_n, {
+      {address_of(evm1), make_asset(1'0000)},
+      {address_of(evm2), make_asset(5000)},
+      {address_of(evm1), make_asset(5000)}
+   });
+
+   BOOST_REQUIRE(evm_balance(evm1) == smallest * 1'5000);
+   BOOST_REQUIRE(evm_balance(evm2) == smallest * 5000);
+   BOOST_REQUIRE_EQUAL(vault_balance_token("alice"_n), 3'0000);
+   BOOST_REQUIRE(inevm() == balance_and_dust{make_asset(2'0000)});
+
+   BOOST_REQUIRE_EXCEPTION(depositmany("alice"_n, {{address_of(evm1), make_asset(2'0000)}, {address_of(evm2), make_asset(2'0000)}}),
+                           eosio_assert_message_exception, eosio_assert_message_is("overdrawn balance"));
+
+   BOOST_REQUIRE_EXCEPTION(depositmany("alice"_n, {{bytes(19), make_asset(1'0000)}}),
+                           eosio_assert_message_exception, eosio_assert_message_is("invalid address"));
+
+   BOOST_REQUIRE_EXCEPTION(depositmany("bob"_n, {{address_of(evm1), make_asset(1'0000)}}),
+                           eosio_assert_message_exception, eosio_assert_message_is("account is not open"));
+
+   //same again with the transactions executed in the action itself
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+
+   auto trace = depositmany("alice"_n, {
+      {address_of(evm2), make_asset(1'0000)},
+      {address_of(evm1), make_asset(1'0000)}
+   });
+
+   size_t events = 0;
+   for(const auto& at : trace->action_traces) {
+      if(at.act.name == "evmtx"_n)
+         ++events;
+   }
+   BOOST_REQUIRE_EQUAL(events, 2u);
+
+   BOOST_REQUIRE(evm_balance(evm1) == smallest * 2'5000);
+   BOOST_REQUIRE(evm_balance(evm2) == smallest * 1'5000);
+   BOOST_REQUIRE_EQUAL(vault_balance_token("alice"_n), 1'0000);
+   check_balances();
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
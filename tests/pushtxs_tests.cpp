@@ -0,0 +1,233 @@
+#include "basic_evm_tester.hpp"
+
+using namespace evm_test;
+using eosio::testing::eosio_assert_message_is;
+
+struct pushtxs_tester : basic_evm_tester {
+   pushtxs_tester() {
+      create_accounts({"alice"_n});
+      transfer_token(faucet_account_name, "alice"_n, make_asset(10000'0000));
+      init();
+   }
+
+   size_t count_actions(const transaction_trace_ptr& trace, name action_name) {
+      size_t total = 0;
+      for (const auto& at : trace->action_traces) {
+         if (at.act.name == action_name) ++total;
+      }
+      return total;
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(pushtxs_tests)
+BOOST_FIXTURE_TEST_CASE(pushtxs_basic, pushtxs_tester) try {
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+
+   evm_eoa evm2;
+   evm_eoa evm3;
+   auto tx1 = generate_tx(evm2.address, 1_ether);
+   evm1.sign(tx1);
+   auto tx2 = generate_tx(evm3.address, 2_ether);
+   evm1.sign(tx2);
+   auto tx3 = generate_tx(evm2.address, 3_ether);
+   evm1.sign(tx3);
+
+   auto trace = pushtxs({tx1, tx2, tx3});
+
+   // One evmtx event per transaction, in order
+   BOOST_REQUIRE(count_actions(trace, "evmtx"_n) == 3);
+   BOOST_REQUIRE(get_tx_from_trace(trace->action_traces[1].act.data).to == evm2.address);
+   BOOST_REQUIRE(get_tx_from_trace(trace->action_traces[2].act.data).to == evm3.address);
+
+   BOOST_REQUIRE(evm_balance(evm2) == 4_ether);
+   BOOST_REQUIRE(evm_balance(evm3) == 2_ether);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(pushtxs_invalid_tx, pushtxs_tester) try {
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+
+   BOOST_REQUIRE_EXCEPTION(pushtxs({}),
+      eosio_assert_message_exception, eosio_assert_message_is("no transactions"));
+
+   evm_eoa evm2;
+   auto tx1 = generate_tx(evm2.address, 1_ether);
+   evm1.sign(tx1);
+   // Skipped nonce
+   evm1.next_nonce++;
+   auto tx2 = generate_tx(evm2.address, 1_ether);
+   evm1.sign(tx2);
+
+   // A transaction failing validation reverts the whole batch
+   BOOST_REQUIRE_THROW(pushtxs({tx1, tx2}), eosio_assert_message_exception);
+   BOOST_REQUIRE(!evm_balance(evm2).has_value());
+
+   pushtxs({tx1});
+   BOOST_REQUIRE(evm_balance(evm2) == 1_ether);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(pushtxs_fanout_batch, pushtxs_tester) try {
+
+   // Distributor.sol: every transaction opens a call frame per recipient and releases it again,
+   // which is the allocation pattern WITH_POOL_ALLOCATOR recycles across the batch
+   const std::string fanout_bytecode =
+      "608060405234801561001057600080fd5b50610284806100206000396000f3fe60806040526004361061001e5760003560e01c"
+      "80632929abe614610023575b600080fd5b610036610031366004610154565b610038565b005b6000805b848110156100f45785"
+      "8582818110610056576100566101c0565b905060200201602081019061006b91906101d6565b6001600160a01b03166108fc85"
+      "8584818110610089576100896101c0565b905060200201359081150290604051600060405180830381858888f1935050505015"
+      "80156100bb573d6000803e3d6000fd5b508383828181106100ce576100ce6101c0565b90506020020135826100e0919061021c"
+      "565b9150806100ec81610235565b91505061003c565b5034811461010157600080fd5b5050505050565b60008083601f840112"
+      "61011a57600080fd5b50813567ffffffffffffffff81111561013257600080fd5b6020830191508360208260051b8501011115"
+      "61014d57600080fd5b9250929050565b6000806000806040858703121561016a57600080fd5b843567ffffffffffffffff8082"
+      "111561018257600080fd5b61018e88838901610108565b909650945060208701359150808211156101a757600080fd5b506101"
+      "b487828801610108565b95989497509550505050565b634e487b7160e01b600052603260045260246000fd5b60006020828403"
+      "12156101e857600080fd5b81356001600160a01b03811681146101ff57600080fd5b9392505050565b634e487b7160e01b6000"
+      "52601160045260246000fd5b8082018082111561022f5761022f610206565b92915050565b6000600182016102475761024761"
+      "0206565b506001019056fea26469706673582212209964e90f15129fadc3f3ade8e9fcd3b3d9c3f27617b3bcc28cf29cc5e3e5"
+      "b5dc64736f6c63430008110033";
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+   const evmc::address fanout_addr = deploy_contract(evm1, evmc::from_hex(fanout_bytecode).value());
+
+   evm_eoa r1, r2, r3;
+   const std::vector<evmc::address> recipients{r1.address, r2.address, r3.address};
+   silkworm::Bytes data = evmc::from_hex("0x2929abe6"                                           //distribute(address[],uint256[])
+                                         "0000000000000000000000000000000000000000000000000000000000000040"
+                                         "00000000000000000000000000000000000000000000000000000000000000c0"
+                                         "0000000000000000000000000000000000000000000000000000000000000003").value();
+   for (const auto& r : recipients) data += silkworm::to_bytes32(r);
+   data += evmc::bytes32{3};
+   for (size_t i = 0; i < recipients.size(); ++i) data += evmc::bytes32{1};
+
+   const size_t batch_size = 16;
+   auto make_batch = [&]() {
+      std::vector<silkworm::Transaction> txs;
+      for (size_t i = 0; i < batch_size; ++i) {
+         auto txn = generate_tx(fanout_addr, 3, 300'000);
+         txn.data = data;
+         evm1.sign(txn);
+         txs.push_back(txn);
+      }
+      return txs;
+   };
+   pushtxs(make_batch());
+
+   for (const auto& r : recipients) {
+      BOOST_REQUIRE(evm_balance(r) == intx::uint256{batch_size});
+   }
+
+   // Per-transaction WITH_TX_STATS report of the batch run by the given build
+   auto batch_stats = [&](const std::vector<uint8_t>& wasm, const std::vector<char>& abi) {
+      set_code(evm_account_name, wasm);
+      set_abi(evm_account_name, abi.data());
+      produce_block();
+      auto trace = pushtxs(make_batch());
+      auto stats = fc::raw::unpack<std::vector<tx_stats>>(trace->action_traces[0].return_value);
+      BOOST_REQUIRE(stats.size() == batch_size);
+      return stats;
+   };
+
+   // Pages depend on how silkworm and evmone allocate, so they are reported but not compared.
+   // pool_allocator_reuses_memory checks the allocator itself.
+   const auto plain = batch_stats(testing::contracts::evm_runtime_stats_wasm(), testing::contracts::evm_runtime_stats_abi());
+   const auto pool = batch_stats(testing::contracts::evm_runtime_pool_wasm(), testing::contracts::evm_runtime_pool_abi());
+   dlog("memory pages: ${plain} without pool, ${pool} with pool",
+        ("plain", plain.back().memory_pages)("pool", pool.back().memory_pages));
+
+   // The fan-out code is loaded from the table once, the rest of the batch hits the state's cache
+   BOOST_REQUIRE(plain[0].db.code.read == 1);
+   BOOST_REQUIRE(plain[0].db.code_bytes > 0);
+   for (size_t i = 1; i < plain.size(); ++i) {
+      BOOST_REQUIRE(plain[i].db.code.read == 0);
+      BOOST_REQUIRE(plain[i].db.code_bytes == 0);
+   }
+
+   for (const auto& r : recipients) {
+      BOOST_REQUIRE(evm_balance(r) == intx::uint256{3 * batch_size});
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(pool_allocator_reuses_memory, pushtxs_tester) try {
+
+   // Linear memory size after each of a number of identical rounds of allocations
+   auto round_pages = [&](const std::vector<uint8_t>& wasm, const std::vector<char>& abi) {
+      set_code(evm_account_name, wasm);
+      set_abi(evm_account_name, abi.data());
+      produce_block();
+      auto trace = push_action(evm_account_name, "testalloc"_n, evm_account_name, mvo()("rounds", 8));
+      auto pages = fc::raw::unpack<std::vector<uint32_t>>(trace->action_traces[0].return_value);
+      BOOST_REQUIRE(pages.size() == 8);
+      return pages;
+   };
+
+   // CDT's malloc never frees, every round takes new pages
+   const auto plain = round_pages(testing::contracts::evm_runtime_stats_wasm(), testing::contracts::evm_runtime_stats_abi());
+   BOOST_REQUIRE(plain.back() > plain.front());
+
+   // With the pool, later rounds are served from what the first one freed
+   const auto pool = round_pages(testing::contracts::evm_runtime_pool_wasm(), testing::contracts::evm_runtime_pool_abi());
+   for (auto pages : pool) {
+      BOOST_REQUIRE(pages == pool.front());
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(pushtxs_stats_fixed_rows, pushtxs_tester) try {
+
+   // RAM estimated for an account and an account2 row
+   constexpr int64_t account_bytes = 347;
+   constexpr int64_t account_v2_bytes = 345;
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+
+   set_code(evm_account_name, testing::contracts::evm_runtime_stats_wasm());
+   set_abi(evm_account_name, testing::contracts::evm_runtime_stats_abi().data());
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+
+   auto push_stats = [&](const evmc::address& to) {
+      auto txn = generate_tx(to, 1_ether);
+      evm1.sign(txn);
+      auto trace = pushtxs({txn});
+      auto stats = fc::raw::unpack<std::vector<tx_stats>>(trace->action_traces[0].return_value);
+      BOOST_REQUIRE(stats.size() == 1);
+      return stats[0].db;
+   };
+
+   // A new recipient takes a legacy account row
+   evm_eoa evm2;
+   auto db = push_stats(evm2.address);
+   BOOST_REQUIRE(db.account.create == 1);
+   BOOST_REQUIRE(db.account.remove == 0);
+   BOOST_REQUIRE(db.ram_delta == account_bytes);
+
+   usefixedrows(evm_account_name);
+   produce_blocks(2);
+
+   // The sender's row moves to account2 and the new recipient is created there
+   evm_eoa evm3;
+   db = push_stats(evm3.address);
+   BOOST_REQUIRE(db.account.create == 2);
+   BOOST_REQUIRE(db.account.remove == 1);
+   BOOST_REQUIRE(db.ram_delta == account_v2_bytes + (account_v2_bytes - account_bytes));
+
+   // Both are fixed-width now
+   evm_eoa evm4;
+   db = push_stats(evm4.address);
+   BOOST_REQUIRE(db.account.create == 1);
+   BOOST_REQUIRE(db.account.remove == 0);
+   BOOST_REQUIRE(db.ram_delta == account_v2_bytes);
+
+} FC_LOG_AND_RETHROW()
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#include "basic_evm_tester.hpp"
+#include <ethash/keccak.hpp>
+
+using namespace evm_test;
+using eosio::testing::eosio_assert_message_is;
+
+struct recover_tester : basic_evm_tester {
+   recover_tester() {
+      init();
+   }
+
+   transaction_trace_ptr testrecover(const silkworm::Transaction& trx, const evmc::address& expected) {
+      silkworm::Bytes rlp;
+      silkworm::rlp::encode(rlp, trx, false);
+      return push_action(evm_account_name, "testrecover"_n, evm_account_name,
+         mvo()("rlptx", bytes{rlp.begin(), rlp.end()})("expected", bytes{std::begin(expected.bytes), std::end(expected.bytes)}));
+   }
+
+   transaction_trace_ptr testkeccak(const bytes& data, const bytes& expected) {
+      return push_action(evm_account_name, "testkeccak"_n, evm_account_name,
+         mvo()("data", data)("expected", expected));
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(recover_tests)
+BOOST_FIXTURE_TEST_CASE(host_recover_matches_wasm, recover_tester) try {
+
+   evm_eoa to;
+   for (int i = 0; i < 8; ++i) {
+      evm_eoa from;
+
+      // EIP-155 legacy
+      auto txn = generate_tx(to.address, 1, 21000);
+      from.sign(txn);
+      testrecover(txn, from.address);
+
+      // pre EIP-155 legacy
+      txn = generate_tx(to.address, 1, 21000);
+      from.sign(txn, {});
+      testrecover(txn, from.address);
+
+      // EIP-2930 and EIP-1559
+      for (auto type : {silkworm::TransactionType::kAccessList, silkworm::TransactionType::kDynamicFee}) {
+         silkworm::Transaction typed{
+            silkworm::UnsignedTransaction {
+               .type = type,
+               .max_priority_fee_per_gas = suggested_gas_price,
+               .max_fee_per_gas = suggested_gas_price,
+               .gas_limit = 21000,
+               .to = to.address,
+               .value = 1,
+               .data = evmc::from_hex("0xdeadbeef").value(),
+            }
+         };
+         from.sign(typed);
+         testrecover(typed, from.address);
+      }
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(host_recover_tampered, recover_tester) try {
+
+   evm_eoa from;
+   evm_eoa to;
+   auto txn = generate_tx(to.address, 1, 21000);
+   from.sign(txn);
+
+   // Still a valid signature, but for some other key
+   txn.value = 2;
+   BOOST_REQUIRE_EXCEPTION(testrecover(txn, from.address),
+      eosio_assert_message_exception, eosio_assert_message_is("unexpected sender"));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(raw_signing_hash_large_calldata, recover_tester) try {
+
+   // Payloads over 255 bytes use multi-byte length prefixes on both the list and the calldata
+   evm_eoa from;
+   evm_eoa to;
+   silkworm::Bytes data(1000, 0x5a);
+
+   auto txn = generate_tx(to.address, 1, 100000);
+   txn.data = data;
+   from.sign(txn);
+   testrecover(txn, from.address);
+
+   silkworm::Transaction typed{
+      silkworm::UnsignedTransaction {
+         .type = silkworm::TransactionType::kDynamicFee,
+         .max_priority_fee_per_gas = suggested_gas_price,
+         .max_fee_per_gas = suggested_gas_price,
+         .gas_limit = 100000,
+         .to = to.address,
+         .value = 1,
+         .data = data,
+      }
+   };
+   from.sign(typed);
+   testrecover(typed, from.address);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(host_keccak_matches_wasm, recover_tester) try {
+
+   // Lengths around the 136 byte keccak256 rate, plus the 32 byte fast path
+   const std::vector<size_t> lengths = {0, 1, 31, 32, 33, 135, 136, 137, 271, 272, 273, 1000};
+
+   auto check_build = [&](const std::vector<uint8_t>& wasm, const std::vector<char>& abi) {
+      set_code(evm_account_name, wasm);
+      set_abi(evm_account_name, abi.data());
+      produce_block();
+
+      for (size_t len : lengths) {
+         bytes data(len);
+         for (size_t i = 0; i < len; ++i) data[i] = static_cast<char>(i * 31 + len);
+         auto hash = ethash::keccak256(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+         bytes expected{std::begin(hash.bytes), std::end(hash.bytes)};
+         testkeccak(data, expected);
+
+         expected[0] ^= 1;
+         BOOST_REQUIRE_EXCEPTION(testkeccak(data, expected),
+            eosio_assert_message_exception, eosio_assert_message_is("unexpected keccak256"));
+      }
+   };
+
+   // The host backend also compares itself with the WASM implementation it replaces
+   check_build(testing::contracts::evm_runtime_hostkeccak_wasm(), testing::contracts::evm_runtime_hostkeccak_abi());
+   check_build(testing::contracts::evm_runtime_wasm(), testing::contracts::evm_runtime_abi());
+
+} FC_LOG_AND_RETHROW()
+BOOST_AUTO_TEST_SUITE_END()
@@ -163,6 +163,48 @@ BOOST_FIXTURE_TEST_CASE(set_version, version_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(trimmed_revisions_build, version_tester) try {
+
+    // Same options as the stats build except for WITH_TRIMMED_REVISIONS
+    const auto full_wasm = testing::contracts::evm_runtime_stats_wasm();
+    const auto trimmed_wasm = testing::contracts::evm_runtime_trimmed_wasm();
+    dlog("wasm size: ${full} bytes with every revision, ${trimmed} bytes trimmed",
+         ("full", full_wasm.size())("trimmed", trimmed_wasm.size()));
+    BOOST_REQUIRE(trimmed_wasm.size() < full_wasm.size());
+
+    evm_eoa evm1;
+    transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+    evmc::address contract_address;
+    std::tie(std::ignore, contract_address) = deploy_test_contract(evm1);
+
+    // Runs increment() with the given build and returns the CPU time it took
+    auto increment = [&](const std::vector<uint8_t>& wasm, const std::vector<char>& abi) {
+        set_code(evm_account_name, wasm);
+        set_abi(evm_account_name, abi.data());
+        produce_block();
+        auto txn = generate_tx(contract_address, 0, 100'000);
+        txn.data = evmc::from_hex(increment_).value();
+        evm1.sign(txn);
+        return pushtx(txn)->elapsed.count();
+    };
+
+    // Istanbul
+    auto full_us = increment(full_wasm, testing::contracts::evm_runtime_stats_abi());
+    auto trimmed_us = increment(trimmed_wasm, testing::contracts::evm_runtime_trimmed_abi());
+    dlog("evm_version 0 increment: ${full}us with every revision, ${trimmed}us trimmed", ("full", full_us)("trimmed", trimmed_us));
+    BOOST_REQUIRE(retrieve(contract_address, evm1.address) == 2);
+
+    setversion(1, evm_account_name);
+    produce_blocks(2);
+
+    // Shanghai
+    full_us = increment(full_wasm, testing::contracts::evm_runtime_stats_abi());
+    trimmed_us = increment(trimmed_wasm, testing::contracts::evm_runtime_trimmed_abi());
+    dlog("evm_version 1 increment: ${full}us with every revision, ${trimmed}us trimmed", ("full", full_us)("trimmed", trimmed_us));
+    BOOST_REQUIRE(retrieve(contract_address, evm1.address) == 4);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(traces_in_different_eosevm_version, version_tester) try {
 
     auto config = get_config();
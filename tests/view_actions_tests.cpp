@@ -0,0 +1,167 @@
+#include "basic_evm_tester.hpp"
+#include <ethash/keccak.hpp>
+
+using namespace evm_test;
+using eosio::testing::eosio_assert_message_is;
+
+struct account_summary {
+   bytes    address;
+   bool     exists;
+   uint64_t nonce;
+   bytes    balance;
+   bytes    code_hash;
+};
+FC_REFLECT(account_summary, (address)(exists)(nonce)(balance)(code_hash))
+
+struct storage_cursor {
+   bool     v2;
+   uint64_t id;
+};
+FC_REFLECT(storage_cursor, (v2)(id))
+
+struct storage_entry {
+   bytes key;
+   bytes value;
+};
+FC_REFLECT(storage_entry, (key)(value))
+
+struct storage_page {
+   std::vector<storage_entry>    entries;
+   std::optional<storage_cursor> next;
+};
+FC_REFLECT(storage_page, (entries)(next))
+
+struct view_actions_tester : basic_evm_tester {
+   view_actions_tester() {
+      create_accounts({"alice"_n});
+      transfer_token(faucet_account_name, "alice"_n, make_asset(10000'0000));
+      init();
+   }
+
+   static bytes to_bytes(const evmc::address& addr) {
+      return bytes{std::begin(addr.bytes), std::end(addr.bytes)};
+   }
+
+   template <typename T>
+   T unpack_return(const transaction_trace_ptr& trace) {
+      BOOST_REQUIRE(trace->action_traces.size() == 1);
+      return fc::raw::unpack<T>(trace->action_traces[0].return_value);
+   }
+
+   std::vector<account_summary> getaccounts(const std::vector<evmc::address>& addresses) {
+      std::vector<bytes> addrs;
+      for (const auto& a : addresses) addrs.push_back(to_bytes(a));
+      return unpack_return<std::vector<account_summary>>(
+         push_action(evm_account_name, "getaccounts"_n, evm_account_name, mvo()("addresses", addrs)));
+   }
+
+   bytes getcode(const evmc::address& address) {
+      return unpack_return<bytes>(
+         push_action(evm_account_name, "getcode"_n, evm_account_name, mvo()("address", to_bytes(address))));
+   }
+
+   storage_page getstorage(const evmc::address& address, const std::optional<storage_cursor>& cursor, uint32_t limit) {
+      return unpack_return<storage_page>(
+         push_action(evm_account_name, "getstorage"_n, evm_account_name,
+            mvo()("address", to_bytes(address))("cursor", cursor)("limit", limit)));
+   }
+
+   evmc::address deploy_simple_contract(evm_eoa& evm_account) {
+
+      // // SPDX-License-Identifier: GPL-3.0
+      // pragma solidity >=0.7.0 <0.9.0;
+      // contract Simple {
+      //    uint256 val;
+      //    address payable public owner;
+      //    constructor() {
+      //       owner = payable(msg.sender);
+      //    }
+      //    function setval(uint256 v) public {
+      //       val=v;
+      //    }
+      //    function getval() public view returns (uint256) {
+      //       return val;
+      //    }
+      //    function killme() public {
+      //       selfdestruct(owner);
+      //    }
+      // }
+
+      const std::string simple_bytecode = "608060405234801561001057600080fd5b5033600160006101000a81548173ffffffffffffffffffffffffffffffffffffffff021916908373ffffffffffffffffffffffffffffffffffffffff16021790555061024b806100616000396000f3fe608060405234801561001057600080fd5b506004361061004c5760003560e01c806324d97a4a1461005157806331b6bd061461005b578063559c9c4a146100795780638da5cb5b14610095575b600080fd5b6100596100b3565b005b6100636100ee565b6040516100709190610140565b60405180910390f35b610093600480360381019061008e919061018c565b6100f7565b005b61009d610101565b6040516100aa91906101fa565b60405180910390f35b600160009054906101000a900473ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff16ff5b60008054905090565b8060008190555050565b600160009054906101000a900473ffffffffffffffffffffffffffffffffffffffff1681565b6000819050919050565b61013a81610127565b82525050565b60006020820190506101556000830184610131565b92915050565b600080fd5b61016981610127565b811461017457600080fd5b50565b60008135905061018681610160565b92915050565b6000602082840312156101a2576101a161015b565b5b60006101b084828501610177565b91505092915050565b600073ffffffffffffffffffffffffffffffffffffffff82169050919050565b60006101e4826101b9565b9050919050565b6101f4816101d9565b82525050565b600060208201905061020f60008301846101eb565b9291505056fea26469706673582212204abac6746f4497f12044fdf4568905d560328e27fa03b3b954fc303865b8429764736f6c63430008120033";
+
+      return deploy_contract(evm_account, evmc::from_hex(simple_bytecode).value());
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(view_actions_tests)
+BOOST_FIXTURE_TEST_CASE(account_and_code_views, view_actions_tester) try {
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+   auto contract_addr = deploy_simple_contract(evm1);
+
+   evm_eoa missing;
+   auto summaries = getaccounts({evm1.address, contract_addr, missing.address});
+   BOOST_REQUIRE(summaries.size() == 3);
+
+   BOOST_REQUIRE(summaries[0].exists);
+   BOOST_REQUIRE(summaries[0].nonce == evm1.next_nonce);
+   BOOST_REQUIRE(intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(summaries[0].balance.data())) == *evm_balance(evm1));
+   BOOST_REQUIRE(memcmp(summaries[0].code_hash.data(), silkworm::kEmptyHash.bytes, 32) == 0);
+
+   BOOST_REQUIRE(summaries[1].exists);
+   BOOST_REQUIRE(!summaries[2].exists);
+
+   // Code is returned as stored, and its hash matches the summary
+   auto code = getcode(contract_addr);
+   BOOST_REQUIRE(!code.empty());
+   auto hash = ethash::keccak256(reinterpret_cast<const uint8_t*>(code.data()), code.size());
+   BOOST_REQUIRE(memcmp(hash.bytes, summaries[1].code_hash.data(), 32) == 0);
+
+   BOOST_REQUIRE(getcode(evm1.address).empty());
+   BOOST_REQUIRE(getcode(missing.address).empty());
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(storage_pages, view_actions_tester) try {
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+   auto contract_addr = deploy_simple_contract(evm1);
+
+   // Slot 0 holds val, slot 1 the owner
+   auto txn = generate_tx(contract_addr, 0, 500'000);
+   txn.data = evmc::from_hex("0x559c9c4a").value();   // setval(uint256)
+   txn.data += evmc::from_hex("0x0000000000000000000000000000000000000000000000000000000000000042").value();
+   evm1.sign(txn);
+   pushtx(txn);
+
+   auto page = getstorage(contract_addr, {}, 10);
+   BOOST_REQUIRE(page.entries.size() == 2);
+   BOOST_REQUIRE(!page.next.has_value());
+
+   std::map<intx::uint256, intx::uint256> slots;
+   for (const auto& e : page.entries) {
+      BOOST_REQUIRE(e.key.size() == 32 && e.value.size() == 32);
+      slots[intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(e.key.data()))] =
+         intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(e.value.data()));
+   }
+   BOOST_REQUIRE(slots[0] == 0x42);
+
+   // One slot per page, following the cursor
+   page = getstorage(contract_addr, {}, 1);
+   BOOST_REQUIRE(page.entries.size() == 1);
+   BOOST_REQUIRE(page.next.has_value());
+   auto first_key = page.entries[0].key;
+   page = getstorage(contract_addr, page.next, 1);
+   BOOST_REQUIRE(page.entries.size() == 1);
+   BOOST_REQUIRE(page.entries[0].key != first_key);
+   BOOST_REQUIRE(!page.next.has_value());
+
+   BOOST_REQUIRE(getstorage(evm1.address, {}, 10).entries.empty());
+
+   BOOST_REQUIRE_EXCEPTION(getstorage(contract_addr, {}, 0),
+      eosio_assert_message_exception, eosio_assert_message_is("limit must be positive"));
+
+} FC_LOG_AND_RETHROW()
+BOOST_AUTO_TEST_SUITE_END()